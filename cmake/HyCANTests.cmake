@@ -3,12 +3,32 @@ add_executable(HyCAN_InterfaceTest ${PROJECT_SOURCE_DIR}/tests/InterfaceTest.cpp
 add_executable(HyCAN_InterfaceStressTest ${PROJECT_SOURCE_DIR}/tests/InterfaceStressTest.cpp)
 add_executable(HyCAN_DaemonConcurrencyTest ${PROJECT_SOURCE_DIR}/tests/DaemonConcurrencyTest.cpp)
 add_executable(HyCAN_DaemonConcurrencyWorker ${PROJECT_SOURCE_DIR}/tests/DaemonConcurrencyWorker.cpp)
+add_executable(HyCAN_ReceiveBatchBenchmark ${PROJECT_SOURCE_DIR}/tests/ReceiveBatchBenchmark.cpp)
+add_executable(HyCAN_DispatchTableBenchmark ${PROJECT_SOURCE_DIR}/tests/DispatchTableBenchmark.cpp)
+add_executable(HyCAN_DispatcherContentionBenchmark ${PROJECT_SOURCE_DIR}/tests/DispatcherContentionBenchmark.cpp)
+add_executable(HyCAN_CompactDispatchBenchmark ${PROJECT_SOURCE_DIR}/tests/CompactDispatchBenchmark.cpp)
+add_executable(HyCAN_ReceiveModeBenchmark ${PROJECT_SOURCE_DIR}/tests/ReceiveModeBenchmark.cpp)
+add_executable(HyCAN_DispatcherGroupTest ${PROJECT_SOURCE_DIR}/tests/DispatcherGroupTest.cpp)
+add_executable(HyCAN_DeferredCallbackBenchmark ${PROJECT_SOURCE_DIR}/tests/DeferredCallbackBenchmark.cpp)
+add_executable(HyCAN_StaticDispatchBenchmark ${PROJECT_SOURCE_DIR}/tests/StaticDispatchBenchmark.cpp)
+add_executable(HyCAN_AsyncReceiveBenchmark ${PROJECT_SOURCE_DIR}/tests/AsyncReceiveBenchmark.cpp)
+add_executable(HyCAN_BatchSendBenchmark ${PROJECT_SOURCE_DIR}/tests/BatchSendBenchmark.cpp)
 
 target_link_libraries(HyCAN_NetlinkTest PRIVATE HyCAN)
 target_link_libraries(HyCAN_InterfaceTest PRIVATE HyCAN)
 target_link_libraries(HyCAN_InterfaceStressTest PRIVATE HyCAN)
 target_link_libraries(HyCAN_DaemonConcurrencyTest PRIVATE HyCAN)
 target_link_libraries(HyCAN_DaemonConcurrencyWorker PRIVATE HyCAN)
+target_link_libraries(HyCAN_ReceiveBatchBenchmark PRIVATE HyCAN)
+target_link_libraries(HyCAN_DispatchTableBenchmark PRIVATE HyCAN)
+target_link_libraries(HyCAN_DispatcherContentionBenchmark PRIVATE HyCAN)
+target_link_libraries(HyCAN_CompactDispatchBenchmark PRIVATE HyCAN)
+target_link_libraries(HyCAN_ReceiveModeBenchmark PRIVATE HyCAN)
+target_link_libraries(HyCAN_DispatcherGroupTest PRIVATE HyCAN)
+target_link_libraries(HyCAN_DeferredCallbackBenchmark PRIVATE HyCAN)
+target_link_libraries(HyCAN_StaticDispatchBenchmark PRIVATE HyCAN)
+target_link_libraries(HyCAN_AsyncReceiveBenchmark PRIVATE HyCAN)
+target_link_libraries(HyCAN_BatchSendBenchmark PRIVATE HyCAN)
 
 add_test(
         NAME NetlinkUpDownTest
@@ -30,3 +50,53 @@ add_test(
         COMMAND HyCAN_DaemonConcurrencyTest
         WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
 )
+
+add_test(
+        NAME ReceiveBatchBenchmark
+        COMMAND HyCAN_ReceiveBatchBenchmark
+)
+
+add_test(
+        NAME DispatchTableBenchmark
+        COMMAND HyCAN_DispatchTableBenchmark
+)
+
+add_test(
+        NAME DispatcherContentionBenchmark
+        COMMAND HyCAN_DispatcherContentionBenchmark
+)
+
+add_test(
+        NAME CompactDispatchBenchmark
+        COMMAND HyCAN_CompactDispatchBenchmark
+)
+
+add_test(
+        NAME ReceiveModeBenchmark
+        COMMAND HyCAN_ReceiveModeBenchmark
+)
+
+add_test(
+        NAME DispatcherGroupTest
+        COMMAND HyCAN_DispatcherGroupTest
+)
+
+add_test(
+        NAME DeferredCallbackBenchmark
+        COMMAND HyCAN_DeferredCallbackBenchmark
+)
+
+add_test(
+        NAME StaticDispatchBenchmark
+        COMMAND HyCAN_StaticDispatchBenchmark
+)
+
+add_test(
+        NAME AsyncReceiveBenchmark
+        COMMAND HyCAN_AsyncReceiveBenchmark
+)
+
+add_test(
+        NAME BatchSendBenchmark
+        COMMAND HyCAN_BatchSendBenchmark
+)
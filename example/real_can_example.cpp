@@ -54,11 +54,12 @@ int main() {
     // The callback will receive all frames since we provide an empty set of
     // IDs.
     auto result =
-        can_interface.register_callback({0x123}, callback).and_then([&] {
-            std::cout << "Bringing up 'can0' with bitrate 1000000..."
-                      << std::endl;
-            return can_interface.up(1000000);
-        });
+        can_interface.register_callback({0x123}, callback)
+            .and_then([&](HyCAN::CallbackHandle) {
+                std::cout << "Bringing up 'can0' with bitrate 1000000..."
+                          << std::endl;
+                return can_interface.up(1000000);
+            });
 
     if (!result) {
         std::cerr << "Failed to set up CAN interface: "
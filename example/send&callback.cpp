@@ -35,13 +35,14 @@ int main() {
     std::this_thread::sleep_for(std::chrono::seconds(1));
 
     auto result =
-        vcan_interface.register_callback({0x100}, callback).and_then([&] {
-            std::cout
-                << "Bringing up VCAN interface with default bitrate (1000000)"
-                << std::endl;
-            return vcan_interface
-                .up(); // Uses default 1000000, but ignored for VCAN
-        });
+        vcan_interface.register_callback({0x100}, callback)
+            .and_then([&](HyCAN::CallbackHandle) {
+                std::cout << "Bringing up VCAN interface with default "
+                             "bitrate (1000000)"
+                          << std::endl;
+                return vcan_interface
+                    .up(); // Uses default 1000000, but ignored for VCAN
+            });
     if (!result) {
         std::cerr << "Failed to set up VCAN interface: "
                   << result.error().message << std::endl;
@@ -64,12 +65,14 @@ int main() {
     VCANInterface vcan_interface2("vcan1");
     std::this_thread::sleep_for(std::chrono::seconds(1));
 
-    result = vcan_interface2.register_callback({0x100}, callback).and_then([&] {
-        std::cout << "Bringing up VCAN interface with custom bitrate (500000)"
-                  << std::endl;
-        return vcan_interface2.up(
-            500000); // Custom bitrate, but ignored for VCAN
-    });
+    result = vcan_interface2.register_callback({0x100}, callback)
+                 .and_then([&](HyCAN::CallbackHandle) {
+                     std::cout << "Bringing up VCAN interface with custom "
+                                  "bitrate (500000)"
+                               << std::endl;
+                     return vcan_interface2.up(
+                         500000); // Custom bitrate, but ignored for VCAN
+                 });
     if (!result) {
         std::cerr << "Failed to set up VCAN interface: "
                   << result.error().message << std::endl;
@@ -62,14 +62,16 @@ namespace HyCAN
         RequestType operation{RequestType::SET_INTERFACE_STATE};
         bool up{};
         bool set_bitrate{};
+        bool fd_mode{}; // Enable CAN FD (CAN_CTRLMODE_FD) with data_bitrate
         uint32_t bitrate{};
+        uint32_t data_bitrate{}; // CAN FD data-phase bitrate
         char interface_name[IFNAMSIZ]{}; // 使用固定大小的字符数组
 
         NetlinkRequest() = default;
 
         explicit NetlinkRequest(const std::string_view name, const bool state, const bool bitrate_flag = false,
-                                const uint32_t rate = 1000000)
-            : up(state), set_bitrate(bitrate_flag), bitrate(rate)
+                                const uint32_t rate = 1000000, const uint32_t data_rate = 0)
+            : up(state), set_bitrate(bitrate_flag), fd_mode(data_rate != 0), bitrate(rate), data_bitrate(data_rate)
         {
             std::strncpy(interface_name, name.data(), sizeof interface_name - 1);
             interface_name[sizeof interface_name - 1] = 0;
@@ -26,7 +26,8 @@ namespace HyCAN
 
         // Private netlink operation methods
         NetlinkResponse set_interface_state_libnl(std::string_view interface_name, bool up) const;
-        NetlinkResponse set_can_bitrate_libnl(std::string_view interface_name, uint32_t bitrate) const;
+        NetlinkResponse set_can_bitrate_libnl(std::string_view interface_name, uint32_t bitrate,
+                                              uint32_t data_bitrate = 0) const;
 
     public:
         NetlinkManager();
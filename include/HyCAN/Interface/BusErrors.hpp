@@ -0,0 +1,164 @@
+#ifndef HYCAN_BUS_ERRORS_HPP
+#define HYCAN_BUS_ERRORS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include <linux/can.h>
+#include <linux/can/error.h>
+
+#include "Socket.hpp"
+
+namespace HyCAN {
+// Controller state as last announced by an error frame.
+enum class BusState : uint8_t {
+    ErrorActive,
+    ErrorWarning,
+    ErrorPassive,
+    BusOff
+};
+
+// Error frames of one interface, decoded by class. A frame may carry
+// several classes and so count towards several fields.
+struct BusErrorStats {
+    uint64_t error_frames = 0;
+    uint64_t tx_timeouts = 0;          // CAN_ERR_TX_TIMEOUT
+    uint64_t lost_arbitration = 0;     // CAN_ERR_LOSTARB
+    uint64_t controller_overflows = 0; // CAN_ERR_CRTL_{RX,TX}_OVERFLOW
+    uint64_t error_warning = 0;        // reached the warning level
+    uint64_t error_passive = 0;        // reached error-passive
+    uint64_t protocol_violations = 0;  // CAN_ERR_PROT
+    uint64_t transceiver_errors = 0;   // CAN_ERR_TRX
+    uint64_t ack_errors = 0;           // CAN_ERR_ACK
+    uint64_t bus_off = 0;              // CAN_ERR_BUSOFF
+    uint64_t bus_errors = 0;           // CAN_ERR_BUSERROR, if in error_mask
+    uint64_t restarts = 0;             // CAN_ERR_RESTARTED
+    BusState state = BusState::ErrorActive;
+    // From the last frame carrying CAN_ERR_CNT.
+    uint8_t tx_error_counter = 0;
+    uint8_t rx_error_counter = 0;
+    RxTimestamp last_error{};
+};
+
+/**
+ * @brief Decodes error frames (CAN_ERR_FLAG) into BusErrorStats.
+ *
+ * Written by the reap thread alone with relaxed loads and stores; any
+ * thread may take a snapshot, which may be off by a frame being recorded.
+ */
+class BusErrorCounters {
+  public:
+    void record(const canfd_frame &frame, const RxTimestamp at) noexcept {
+        const canid_t classes = frame.can_id & CAN_ERR_MASK;
+        const uint8_t controller = frame.data[1];
+        bump(error_frames, true);
+        bump(tx_timeouts, classes & CAN_ERR_TX_TIMEOUT);
+        bump(lost_arbitration, classes & CAN_ERR_LOSTARB);
+        bump(protocol_violations, classes & CAN_ERR_PROT);
+        bump(transceiver_errors, classes & CAN_ERR_TRX);
+        bump(ack_errors, classes & CAN_ERR_ACK);
+        bump(bus_off, classes & CAN_ERR_BUSOFF);
+        bump(bus_errors, classes & CAN_ERR_BUSERROR);
+        bump(restarts, classes & CAN_ERR_RESTARTED);
+        if (classes & CAN_ERR_CRTL) {
+            bump(controller_overflows,
+                 controller &
+                     (CAN_ERR_CRTL_RX_OVERFLOW | CAN_ERR_CRTL_TX_OVERFLOW));
+            bump(error_warning, controller & (CAN_ERR_CRTL_RX_WARNING |
+                                              CAN_ERR_CRTL_TX_WARNING));
+            bump(error_passive, controller & (CAN_ERR_CRTL_RX_PASSIVE |
+                                              CAN_ERR_CRTL_TX_PASSIVE));
+        }
+        if (const auto next = state_after(classes, controller)) {
+            state.store(*next, std::memory_order_relaxed);
+        }
+        if (classes & CAN_ERR_CNT) {
+            tx_error_counter.store(frame.data[6], std::memory_order_relaxed);
+            rx_error_counter.store(frame.data[7], std::memory_order_relaxed);
+        }
+        last_error_ns.store(at.time_since_epoch().count(),
+                            std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] BusErrorStats snapshot() const noexcept {
+        const auto load = [](const std::atomic<uint64_t> &counter) {
+            return counter.load(std::memory_order_relaxed);
+        };
+        return {
+            .error_frames = load(error_frames),
+            .tx_timeouts = load(tx_timeouts),
+            .lost_arbitration = load(lost_arbitration),
+            .controller_overflows = load(controller_overflows),
+            .error_warning = load(error_warning),
+            .error_passive = load(error_passive),
+            .protocol_violations = load(protocol_violations),
+            .transceiver_errors = load(transceiver_errors),
+            .ack_errors = load(ack_errors),
+            .bus_off = load(bus_off),
+            .bus_errors = load(bus_errors),
+            .restarts = load(restarts),
+            .state = state.load(std::memory_order_relaxed),
+            .tx_error_counter =
+                tx_error_counter.load(std::memory_order_relaxed),
+            .rx_error_counter =
+                rx_error_counter.load(std::memory_order_relaxed),
+            .last_error = RxTimestamp(std::chrono::nanoseconds(
+                last_error_ns.load(std::memory_order_relaxed))),
+        };
+    }
+
+  private:
+    static void bump(std::atomic<uint64_t> &counter, const bool hit) noexcept {
+        if (hit) {
+            counter.store(counter.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+        }
+    }
+
+    // The most severe state the frame announces, if any.
+    static std::optional<BusState>
+    state_after(const canid_t classes, const uint8_t controller) noexcept {
+        if (classes & CAN_ERR_BUSOFF) {
+            return BusState::BusOff;
+        }
+        if (classes & CAN_ERR_CRTL) {
+            if (controller &
+                (CAN_ERR_CRTL_RX_PASSIVE | CAN_ERR_CRTL_TX_PASSIVE)) {
+                return BusState::ErrorPassive;
+            }
+            if (controller &
+                (CAN_ERR_CRTL_RX_WARNING | CAN_ERR_CRTL_TX_WARNING)) {
+                return BusState::ErrorWarning;
+            }
+            if (controller & CAN_ERR_CRTL_ACTIVE) {
+                return BusState::ErrorActive;
+            }
+        }
+        if (classes & CAN_ERR_RESTARTED) {
+            return BusState::ErrorActive;
+        }
+        return std::nullopt;
+    }
+
+    std::atomic<uint64_t> error_frames{0};
+    std::atomic<uint64_t> tx_timeouts{0};
+    std::atomic<uint64_t> lost_arbitration{0};
+    std::atomic<uint64_t> controller_overflows{0};
+    std::atomic<uint64_t> error_warning{0};
+    std::atomic<uint64_t> error_passive{0};
+    std::atomic<uint64_t> protocol_violations{0};
+    std::atomic<uint64_t> transceiver_errors{0};
+    std::atomic<uint64_t> ack_errors{0};
+    std::atomic<uint64_t> bus_off{0};
+    std::atomic<uint64_t> bus_errors{0};
+    std::atomic<uint64_t> restarts{0};
+    std::atomic<BusState> state{BusState::ErrorActive};
+    std::atomic<uint8_t> tx_error_counter{0};
+    std::atomic<uint8_t> rx_error_counter{0};
+    std::atomic<int64_t> last_error_ns{0};
+};
+} // namespace HyCAN
+
+#endif // HYCAN_BUS_ERRORS_HPP
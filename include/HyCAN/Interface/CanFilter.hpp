@@ -0,0 +1,24 @@
+#ifndef HYCAN_CAN_FILTER_HPP
+#define HYCAN_CAN_FILTER_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <linux/can.h>
+
+namespace HyCAN {
+/**
+ * @brief Build a CAN_RAW_FILTER list accepting every key in `keys`.
+ *
+ * Keys are standard IDs or extended IDs carrying CAN_EFF_FLAG. While the
+ * list is longer than `max_filters`, the pair of neighbouring filters whose
+ * smallest common aligned id/mask block admits the fewest unsubscribed IDs
+ * is merged, so the result may let some extra IDs through but never drops a
+ * subscribed one.
+ */
+std::vector<can_filter> build_can_filters(std::span<const canid_t> keys,
+                                          size_t max_filters);
+} // namespace HyCAN
+
+#endif // HYCAN_CAN_FILTER_HPP
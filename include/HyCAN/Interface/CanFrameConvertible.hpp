@@ -12,6 +12,17 @@ namespace HyCAN
         { static_cast<can_frame>(a) } -> std::same_as<can_frame>;
         { static_cast<T>(can_frame()) } -> std::same_as<T>;
     };
+
+    // Types carrying up to 64 bytes of payload as a CAN FD frame.
+    template <typename T>
+    concept CanFdFrameConvertible = requires(T a)
+    {
+        { static_cast<canfd_frame>(a) } -> std::same_as<canfd_frame>;
+        { static_cast<T>(canfd_frame()) } -> std::same_as<T>;
+    };
+
+    template <typename T>
+    concept AnyCanFrameConvertible = CanFrameConvertible<T> || CanFdFrameConvertible<T>;
 }
 
 #endif //CANFRAMECONVERTIBLE_HPP
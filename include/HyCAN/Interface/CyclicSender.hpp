@@ -0,0 +1,177 @@
+#ifndef HYCAN_CYCLIC_SENDER_HPP
+#define HYCAN_CYCLIC_SENDER_HPP
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string_view>
+
+#include <linux/can.h>
+#include <linux/can/bcm.h>
+#include <tl/expected.hpp>
+
+#include "CanFrameConvertible.hpp"
+#include "HyCAN/Util/Error.hpp"
+
+namespace HyCAN {
+// What the broadcast manager reported for an ID under CyclicSender::watch.
+struct CyclicEvent {
+    enum class Kind {
+        Changed, // a frame differing from the last one in the watched bits
+        Timeout, // no frame for the watch timeout
+    };
+    Kind kind;
+    canid_t can_id;
+    // The new frame for Changed; zero for Timeout. A classic frame fills
+    // the first sizeof(can_frame) bytes, with flags zero.
+    canfd_frame frame;
+};
+
+/**
+ * @brief Cyclic transmission and change detection done by the kernel.
+ *
+ * Wraps a CAN_BCM (broadcast manager) socket. A frame passed to start() is
+ * sent by the kernel every period until stop(), with no user thread, so
+ * the cycle has neither scheduler jitter nor a syscall per period.
+ * update() swaps the payload between two transmissions. watch() has the
+ * kernel compare received frames and report only those whose watched
+ * bits changed, plus timeouts, through read_event().
+ *
+ * Frames are keyed by their can_id, with CAN_EFF_FLAG for extended IDs.
+ * The socket connects on first use; the kernel forgets every cyclic frame
+ * and watch when it closes, so it is not reconnected behind the caller's
+ * back. Not thread-safe, like Sender.
+ */
+class CyclicSender {
+  public:
+    explicit CyclicSender(std::string_view interface_name);
+    CyclicSender(const CyclicSender &) = delete;
+    CyclicSender &operator=(const CyclicSender &) = delete;
+    // Closing the socket stops every cyclic frame.
+    ~CyclicSender();
+
+    // Sends `frame` now and then every `period`. Starting an ID that is
+    // already cyclic replaces its payload and restarts its period.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error> start(const T &frame,
+                                    const std::chrono::microseconds period) {
+        if (period <= std::chrono::microseconds::zero()) {
+            return tl::make_unexpected(Error{ErrorCode::CANBcmError,
+                                             "Cyclic period must be positive"});
+        }
+        const auto wire = to_wire(frame);
+        if (const auto it = cyclic.find(wire.can_id);
+            it != cyclic.end() && it->second != is_fd<T>()) {
+            // The kernel keys classic and FD frames apart.
+            if (auto res = stop(wire.can_id); !res) {
+                return res;
+            }
+        }
+        if (auto res = setup(TX_SETUP, SETTIMER | STARTTIMER | TX_ANNOUNCE,
+                             wire, is_fd<T>(), {}, period);
+            !res) {
+            return res;
+        }
+        cyclic[wire.can_id] = is_fd<T>();
+        return {};
+    }
+
+    // Replaces the payload of a started frame in one syscall; the period
+    // keeps running. Recent kernels copy it under the lock the transmit
+    // timer takes, so no cycle goes out half old and half new. `announce`
+    // also sends the new frame at once.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error> update(const T &frame,
+                                     const bool announce = false) {
+        const auto wire = to_wire(frame);
+        if (const auto it = cyclic.find(wire.can_id);
+            it == cyclic.end() || it->second != is_fd<T>()) {
+            return tl::make_unexpected(
+                Error{ErrorCode::CANBcmError,
+                      "Cannot update a frame that was not started"});
+        }
+        return setup(TX_SETUP, announce ? TX_ANNOUNCE : 0, wire, is_fd<T>(),
+                     {}, {});
+    }
+
+    tl::expected<void, Error> stop(canid_t can_id);
+
+    // Reports frames on mask.can_id whose payload differs from the last
+    // one in any bit set in `mask`, or whose length changed; the first
+    // frame always counts as a change. With a `timeout`, silence that
+    // long is reported too. A `throttle` caps changes to one per interval,
+    // the latest winning. Watching an ID again replaces its setup.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error>
+    watch(const T &mask, const std::chrono::microseconds timeout = {},
+          const std::chrono::microseconds throttle = {}) {
+        const auto wire = to_wire(mask);
+        if (const auto it = watched.find(wire.can_id);
+            it != watched.end() && it->second != is_fd<T>()) {
+            if (auto res = unwatch(wire.can_id); !res) {
+                return res;
+            }
+        }
+        uint32_t flags = RX_CHECK_DLC | RX_ANNOUNCE_RESUME;
+        if (timeout > std::chrono::microseconds::zero() ||
+            throttle > std::chrono::microseconds::zero()) {
+            flags |= SETTIMER | STARTTIMER;
+        }
+        if (auto res =
+                setup(RX_SETUP, flags, wire, is_fd<T>(), timeout, throttle);
+            !res) {
+            return res;
+        }
+        watched[wire.can_id] = is_fd<T>();
+        return {};
+    }
+
+    tl::expected<void, Error> unwatch(canid_t can_id);
+
+    // Next watch report, or nullopt when none is pending; never blocks.
+    // Poll get_sock_fd() for readability to wait for one.
+    tl::expected<std::optional<CyclicEvent>, Error> read_event() noexcept;
+
+    // -1 until first use.
+    [[nodiscard]] int get_sock_fd() const { return sock_fd; }
+
+  private:
+    template <AnyCanFrameConvertible T> static constexpr bool is_fd() {
+        return !CanFrameConvertible<T>;
+    }
+
+    // Both kinds travel as a canfd_frame; a classic one only uses the
+    // can_frame prefix.
+    template <AnyCanFrameConvertible T>
+    static canfd_frame to_wire(const T &frame) {
+        canfd_frame wire{};
+        if constexpr (CanFrameConvertible<T>) {
+            const auto classic = static_cast<can_frame>(frame);
+            std::memcpy(&wire, &classic, sizeof(classic));
+        } else {
+            wire = static_cast<canfd_frame>(frame);
+        }
+        return wire;
+    }
+
+    tl::expected<void, Error> ensure_connected() noexcept;
+    // Sends one bcm_msg_head carrying `frame`.
+    tl::expected<void, Error> setup(uint32_t opcode, uint32_t flags,
+                                    const canfd_frame &frame, bool fd,
+                                    std::chrono::microseconds ival1,
+                                    std::chrono::microseconds ival2) noexcept;
+    tl::expected<void, Error> remove(uint32_t opcode,
+                                     std::map<canid_t, bool> &tasks,
+                                     canid_t can_id) noexcept;
+
+    int sock_fd{-1};
+    std::string_view interface_name;
+    // Started or watched IDs, and whether as CAN FD; TX_DELETE and
+    // RX_DELETE must name the same kind.
+    std::map<canid_t, bool> cyclic;
+    std::map<canid_t, bool> watched;
+};
+} // namespace HyCAN
+
+#endif // HYCAN_CYCLIC_SENDER_HPP
@@ -0,0 +1,274 @@
+#ifndef HYCAN_DISPATCH_TABLE_HPP
+#define HYCAN_DISPATCH_TABLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <linux/can.h>
+
+namespace HyCAN {
+/**
+ * @brief Callback lookup keyed by raw `can_id`.
+ *
+ * Callbacks for registered IDs sit in one dense vector. Standard (11-bit) IDs
+ * reach it through a direct array of 32-bit positions (8 KB, instead of a
+ * callback object per possible ID); extended (29-bit) IDs go through an
+ * open-addressing hash with linear probing that stays at most half full.
+ * Position 0 holds an empty sentinel callback, so a miss needs no extra
+ * branch before the emptiness check. Extended IDs missing from the hash
+ * fall back to a short list of id/mask entries, most specific first,
+ * which is only walked while it is non-empty.
+ */
+template <typename Callback> class DispatchTable {
+  public:
+    [[nodiscard]] Callback *find(const canid_t can_id) noexcept {
+        uint32_t pos;
+        if (!(can_id & CAN_EFF_FLAG)) [[likely]] {
+            pos = standard[can_id & CAN_SFF_MASK];
+        } else {
+            pos = find_extended(can_id & CAN_EFF_MASK);
+            if (pos == NO_ENTRY && !masks.empty()) [[unlikely]] {
+                return find_masked(can_id & CAN_EFF_MASK);
+            }
+        }
+        Callback &cb = callbacks[pos];
+        return cb ? &cb : nullptr;
+    }
+
+    // Like find(), without the id/mask fallback.
+    [[nodiscard]] Callback *find_key(const canid_t key) noexcept {
+        const uint32_t pos = !(key & CAN_EFF_FLAG)
+                                 ? standard[key & CAN_SFF_MASK]
+                                 : find_extended(key & CAN_EFF_MASK);
+        Callback &cb = callbacks[pos];
+        return cb ? &cb : nullptr;
+    }
+
+    // Extended id/mask entries: they match every 29-bit ID whose bits
+    // under `mask` equal `id`, which has no bits outside `mask`.
+
+    // The entry for exactly this id/mask, if any.
+    [[nodiscard]] Callback *find_mask(const canid_t id,
+                                      const canid_t mask) noexcept {
+        for (auto &entry : masks) {
+            if (entry.id == id && entry.mask == mask) {
+                return &entry.callback;
+            }
+        }
+        return nullptr;
+    }
+
+    // The most specific entry matching every ID that id/mask matches.
+    [[nodiscard]] Callback *covering(const canid_t id,
+                                     const canid_t mask) noexcept {
+        for (auto &entry : masks) {
+            if ((entry.mask & ~mask) == 0 && (id & entry.mask) == entry.id) {
+                return &entry.callback;
+            }
+        }
+        return nullptr;
+    }
+
+    // Returns the entry for id/mask, default-constructing it if absent.
+    Callback &insert_mask(const canid_t id, const canid_t mask) {
+        if (auto *existing = find_mask(id, mask)) {
+            return *existing;
+        }
+        const int bits = std::popcount(mask);
+        const auto it = std::ranges::find_if(masks, [&](const auto &entry) {
+            return std::popcount(entry.mask) < bits;
+        });
+        return masks.insert(it, MaskEntry{id, mask, Callback{}})->callback;
+    }
+
+    // Removes the id/mask entries whose callback `pred` accepts.
+    template <typename Pred> void erase_masks_if(Pred &&pred) {
+        std::erase_if(masks, [&](const MaskEntry &entry) {
+            return pred(entry.callback);
+        });
+    }
+
+    // Calls f(id, mask, callback) for every id/mask entry.
+    template <typename F> void for_each_mask(F &&f) {
+        for (auto &entry : masks) {
+            f(entry.id, entry.mask, entry.callback);
+        }
+    }
+
+    template <typename F> void for_each_mask(F &&f) const {
+        for (const auto &entry : masks) {
+            f(entry.id, entry.mask, entry.callback);
+        }
+    }
+
+    // Returns the slot for `key` (standard ID, or extended ID with
+    // CAN_EFF_FLAG set), default-constructing it if absent.
+    Callback &operator[](const canid_t key) {
+        uint32_t &pos = index_of(key);
+        if (pos == NO_ENTRY) {
+            callbacks.emplace_back();
+            keys.push_back(key);
+            pos = static_cast<uint32_t>(callbacks.size() - 1);
+        }
+        return callbacks[pos];
+    }
+
+    void erase(const canid_t key) {
+        const uint32_t pos = remove_index(key);
+        if (pos == NO_ENTRY) {
+            return;
+        }
+        // Move the last callback into the hole to keep the vector dense.
+        if (pos != callbacks.size() - 1) {
+            callbacks[pos] = std::move(callbacks.back());
+            keys[pos] = keys.back();
+            index_of(keys[pos]) = pos;
+        }
+        callbacks.pop_back();
+        keys.pop_back();
+    }
+
+    // Calls f(key) for every registered key, in no particular order.
+    template <typename F> void for_each_key(F &&f) const {
+        for (size_t i = 1; i < keys.size(); ++i) {
+            if (callbacks[i]) {
+                f(keys[i]);
+            }
+        }
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return callbacks.size() - 1; }
+
+    [[nodiscard]] size_t extended_count() const noexcept {
+        return extended_size;
+    }
+
+    [[nodiscard]] size_t mask_count() const noexcept { return masks.size(); }
+
+  private:
+    // Position of the sentinel; a zeroed index means "not registered".
+    static constexpr uint32_t NO_ENTRY = 0;
+    static constexpr canid_t EMPTY_SLOT = ~canid_t{0};
+
+    struct Slot {
+        canid_t id = EMPTY_SLOT;
+        uint32_t pos = NO_ENTRY;
+    };
+
+    struct MaskEntry {
+        canid_t id;
+        canid_t mask;
+        Callback callback;
+    };
+
+    [[nodiscard]] size_t probe_start(const canid_t id) const noexcept {
+        // Fibonacci hashing spreads the dense low bits of typical IDs.
+        return (static_cast<uint32_t>(id) * 2654435769u) >>
+               (32 - std::countr_zero(extended.size()));
+    }
+
+    [[nodiscard]] Callback *find_masked(const canid_t id) noexcept {
+        for (auto &entry : masks) {
+            if ((id & entry.mask) == entry.id) {
+                return entry.callback ? &entry.callback : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] uint32_t find_extended(const canid_t id) const noexcept {
+        if (extended_size == 0) {
+            return NO_ENTRY;
+        }
+        const size_t mask = extended.size() - 1;
+        for (size_t pos = probe_start(id);; pos = (pos + 1) & mask) {
+            const Slot &slot = extended[pos];
+            if (slot.id == id) {
+                return slot.pos;
+            }
+            if (slot.id == EMPTY_SLOT) {
+                return NO_ENTRY;
+            }
+        }
+    }
+
+    // Index cell for `key`, inserting an empty one if absent.
+    uint32_t &index_of(const canid_t key) {
+        if (!(key & CAN_EFF_FLAG)) {
+            return standard[key & CAN_SFF_MASK];
+        }
+        if ((extended_size + 1) * 2 > extended.size()) {
+            rehash(extended.empty() ? 16 : extended.size() * 2);
+        }
+        const canid_t id = key & CAN_EFF_MASK;
+        size_t pos = probe_start(id);
+        while (extended[pos].id != EMPTY_SLOT && extended[pos].id != id) {
+            pos = (pos + 1) & (extended.size() - 1);
+        }
+        if (extended[pos].id == EMPTY_SLOT) {
+            extended[pos].id = id;
+            ++extended_size;
+        }
+        return extended[pos].pos;
+    }
+
+    // Drops `key` from the index and returns its former position.
+    uint32_t remove_index(const canid_t key) {
+        if (!(key & CAN_EFF_FLAG)) {
+            return std::exchange(standard[key & CAN_SFF_MASK], NO_ENTRY);
+        }
+        if (extended.empty()) {
+            return NO_ENTRY;
+        }
+        const canid_t id = key & CAN_EFF_MASK;
+        const size_t mask = extended.size() - 1;
+        size_t pos = probe_start(id);
+        while (extended[pos].id != id) {
+            if (extended[pos].id == EMPTY_SLOT) {
+                return NO_ENTRY;
+            }
+            pos = (pos + 1) & mask;
+        }
+        const uint32_t removed = extended[pos].pos;
+        // Backward-shift deletion keeps probe chains intact without
+        // tombstones.
+        size_t hole = pos;
+        for (size_t next = (hole + 1) & mask; extended[next].id != EMPTY_SLOT;
+             next = (next + 1) & mask) {
+            const size_t home = probe_start(extended[next].id);
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                extended[hole] = extended[next];
+                hole = next;
+            }
+        }
+        extended[hole] = Slot{};
+        --extended_size;
+        return removed;
+    }
+
+    void rehash(const size_t capacity) {
+        std::vector<Slot> old(capacity);
+        old.swap(extended);
+        extended_size = 0;
+        for (const auto &slot : old) {
+            if (slot.id != EMPTY_SLOT) {
+                index_of(slot.id | CAN_EFF_FLAG) = slot.pos;
+            }
+        }
+    }
+
+    std::array<uint32_t, CAN_SFF_MASK + 1> standard{};
+    std::vector<Slot> extended;
+    size_t extended_size = 0;
+    std::vector<Callback> callbacks = std::vector<Callback>(1);
+    std::vector<canid_t> keys = std::vector<canid_t>(1);
+    std::vector<MaskEntry> masks;
+};
+} // namespace HyCAN
+
+#endif // HYCAN_DISPATCH_TABLE_HPP
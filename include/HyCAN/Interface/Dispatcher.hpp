@@ -1,30 +1,252 @@
 #ifndef REAPER_HPP
 #define REAPER_HPP
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <concepts>
+#include <coroutine>
+#include <cstring>
 #include <format>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <span>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <tl/expected.hpp>
 
 #include <linux/can.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
 #include <type_traits>
 
 #include <optional>
 
+#include "BusErrors.hpp"
 #include "CanFrameConvertible.hpp"
+#include "DispatchTable.hpp"
+#include "DispatcherGroup.hpp"
+#include "Executor.hpp"
+#include "IdPattern.hpp"
+#include "HyCAN/Util/InlineFunction.hpp"
+#include "HyCAN/Util/LatencyHistogram.hpp"
+#include "HyCAN/Util/RcuPtr.hpp"
+#include "HyCAN/Util/SmallVector.hpp"
 #include "HyCAN/Util/SpinLock.hpp"
 #include "Socket.hpp"
+#include "TrafficStats.hpp"
+#include "Watchdog.hpp"
+#include "WorkerPool.hpp"
 
 static constexpr size_t MAX_EPOLL_EVENT = 2048;
 
 namespace HyCAN {
+template <typename... Handlers> class StaticDispatcher;
+
+// How the reap thread waits for frames. Dispatchers sharing a
+// DispatcherGroup always use level-triggered Epoll.
+enum class ReceiveMode {
+    // Sleep in epoll_wait until the socket is readable.
+    Epoll,
+    // Sleep in a blocking recvmmsg on the socket itself; skips the epoll
+    // round trip, only meaningful for a single socket.
+    Blocking,
+    // Poll the socket non-blockingly in a tight loop. Lowest latency, but
+    // burns its core: use it on an isolated CPU.
+    Spin,
+    // Like Epoll, but keep polling for `spin_window` after each frame, so
+    // frames arriving in bursts skip the wakeup.
+    Hybrid,
+};
+
+struct DispatcherOptions {
+    // Maximum number of frames pulled from the socket by one recvmmsg call.
+    size_t batch_size = 32;
+    // Register the socket edge-triggered and drain it until EAGAIN.
+    bool edge_triggered = false;
+    // Upper bound on frames handled per wakeup, so a bursty socket cannot
+    // starve the stop eventfd. 0 means one batch.
+    size_t wakeup_budget = 256;
+    // Keep a CAN_RAW_FILTER on the socket matching the registered IDs, so
+    // unsubscribed traffic never wakes the reap thread.
+    bool kernel_filter = true;
+    // Past this many filters, neighbouring IDs are merged into id/mask
+    // blocks that may admit a few unsubscribed IDs.
+    size_t max_kernel_filters = 64;
+    ReceiveMode receive_mode = ReceiveMode::Epoll;
+    // Hybrid mode: how long to keep polling after the last frame.
+    std::chrono::microseconds spin_window{50};
+    // Threads for Delivery::Deferred callbacks, started on the first such
+    // registration. Each deferred callback is bound to one worker.
+    std::vector<WorkerOptions> deferred_workers{WorkerOptions{}};
+    // Frames each worker can hold before new ones are dropped.
+    size_t deferred_queue_depth = 1024;
+    // Have the kernel timestamp every frame (SO_TIMESTAMPNS), pass the
+    // timestamp to callbacks that take one, and collect StageStats.
+    bool rx_timestamps = false;
+    // IDs whose traffic is tracked per ID (see get_id_stats); later IDs
+    // are only counted in total. 0 turns the tracking off.
+    size_t id_stats_capacity = 256;
+    // Error classes (CAN_ERR_* of linux/can/error.h) received as error
+    // frames; they are counted in get_bus_errors() and passed to error
+    // callbacks. CAN_ERR_BUSERROR is opt-in: a degraded bus reports one
+    // per bad frame and can flood the reap thread.
+    can_err_mask_t error_mask = CAN_ERR_MASK & ~CAN_ERR_BUSERROR;
+    // Socket receive buffer in bytes; 0 keeps the kernel default.
+    int receive_buffer = 0;
+    // Grow the receive buffer to hold receive_buffer_headroom of traffic
+    // at the observed frame rate, and double it whenever the kernel drops
+    // frames, up to max_receive_buffer. It never shrinks.
+    bool auto_receive_buffer = false;
+    std::chrono::milliseconds receive_buffer_headroom{100};
+    int max_receive_buffer = 4 << 20;
+};
+
+// A frame callback; it may also take the frame's RxTimestamp.
+template <typename Func, typename T>
+concept FrameHandler =
+    std::invocable<Func, T> || std::invocable<Func, T, RxTimestamp>;
+
+// Hands `frame` to `func` as a T, and with its timestamp if `func` takes
+// one. Classic frame types skip CAN FD frames.
+template <typename T, typename Func>
+void invoke_frame_handler(Func &func, const canfd_frame &frame,
+                          const RxTimestamp timestamp) {
+    const auto call = [&](auto &&converted) {
+        if constexpr (std::invocable<Func &, T, RxTimestamp>) {
+            func(std::forward<decltype(converted)>(converted), timestamp);
+        } else {
+            func(std::forward<decltype(converted)>(converted));
+        }
+    };
+    if constexpr (std::same_as<T, canfd_frame>) {
+        call(frame);
+    } else if constexpr (CanFrameConvertible<T>) {
+        if (frame.flags & CANFD_FDF) {
+            return;
+        }
+        can_frame classic;
+        std::memcpy(&classic, &frame, sizeof(classic));
+        if constexpr (std::same_as<T, can_frame>) {
+            call(classic);
+        } else {
+            call(static_cast<T>(classic));
+        }
+    } else {
+        call(static_cast<T>(frame));
+    }
+}
+
+// Where a callback runs.
+enum class Delivery {
+    // On the reap thread, before the next frame is handled.
+    Inline,
+    // On a worker thread, so a slow callback cannot delay other IDs.
+    Deferred,
+};
+
+static constexpr size_t DRAIN_HISTOGRAM_BUCKETS = 10;
+
+// Identifies one register_func call; pass it back to unregister_func to
+// remove just that callback.
+struct CallbackHandle {
+    uint64_t id = 0;
+
+    explicit operator bool() const noexcept { return id != 0; }
+    bool operator==(const CallbackHandle &) const = default;
+};
+
+class Dispatcher;
+class Mailbox;
+
+/**
+ * @brief One Dispatcher::receive() call: the next data frame on an ID.
+ *
+ * Listens from construction on, so a reply arriving before the co_await
+ * is kept. The reap thread copies the frame in and posts the awaiting
+ * coroutine to its Executor. Neither copyable nor movable; the
+ * dispatcher must outlive it.
+ */
+class FrameWait {
+  public:
+    FrameWait(const FrameWait &) = delete;
+    FrameWait &operator=(const FrameWait &) = delete;
+    ~FrameWait();
+
+    [[nodiscard]] bool await_ready() const noexcept;
+    bool await_suspend(std::coroutine_handle<> handle);
+
+  protected:
+    FrameWait(Dispatcher &dispatcher, size_t can_id,
+              std::chrono::nanoseconds timeout, bool fd_frames);
+    // The frame, or why there is none; on the executor thread.
+    tl::expected<canfd_frame, Error> take();
+
+  private:
+    friend class Dispatcher;
+
+    enum class State : uint8_t {
+        Pending,   // listening, not awaited yet
+        Suspended, // listening, `handle` waits on `executor`
+        Delivered,
+        TimedOut,
+        Failed,
+    };
+
+    static void expire(void *self, bool ready);
+
+    Dispatcher *dispatcher;
+    canid_t key{};
+    // Whether `key` was counted in the dispatcher's awaited keys.
+    bool admitted{false};
+    // Whether CAN FD frames count; classic frame types skip them.
+    bool fd_frames;
+    Executor::Clock::time_point deadline;
+    std::atomic<State> state{State::Pending};
+    canfd_frame frame{};
+    std::optional<Error> error;
+    Executor *executor{nullptr};
+    std::coroutine_handle<> handle;
+    std::optional<Executor::TimerId> timer;
+};
+
+template <AnyCanFrameConvertible T> class FrameAwaiter : public FrameWait {
+  public:
+    tl::expected<T, Error> await_resume() {
+        return take().map([](const canfd_frame &frame) {
+            std::optional<T> converted;
+            auto store = [&converted](T value) {
+                converted.emplace(std::move(value));
+            };
+            invoke_frame_handler<T>(store, frame, {});
+            return std::move(*converted);
+        });
+    }
+
+  private:
+    friend class Dispatcher;
+
+    FrameAwaiter(Dispatcher &dispatcher, const size_t can_id,
+                 const std::chrono::nanoseconds timeout)
+        : FrameWait(dispatcher, can_id, timeout,
+                    std::same_as<T, canfd_frame> || !CanFrameConvertible<T>) {
+    }
+};
+
 class Dispatcher {
   public:
-    explicit Dispatcher(std::string_view interface_name, const std::optional<uint8_t>& cpu_core_opt = std::nullopt);
+    explicit Dispatcher(std::string_view interface_name,
+                        const std::optional<uint8_t> &cpu_core_opt = std::nullopt,
+                        const DispatcherOptions &options = {});
+    // Receive on `group`'s thread instead of a dedicated one.
+    Dispatcher(std::string_view interface_name, DispatcherGroup &group,
+               const DispatcherOptions &options = {});
     Dispatcher() = delete;
     Dispatcher(const Dispatcher &other) = delete;
     Dispatcher(Dispatcher &&other) = delete;
@@ -35,57 +257,500 @@ class Dispatcher {
     tl::expected<void, Error> start() noexcept;
     tl::expected<void, Error> stop() noexcept;
 
+    // IDs up to 0x7FF are standard; larger IDs, or any ID carrying
+    // CAN_EFF_FLAG, are 29-bit extended IDs. Callbacks taking a classic
+    // frame type only see classic frames; CAN FD types see both. Several
+    // callbacks may share an ID; they run in registration order. Remote
+    // (RTR) frames go to register_remote_func callbacks instead.
     template <typename T = can_frame, typename Func>
-        requires(CanFrameConvertible<T> && std::invocable<Func, T>)
-    tl::expected<void, Error> register_func(const std::set<size_t> &can_ids,
-                                            Func &&func) {
-
-        std::function<void(can_frame)> register_func;
-        register_func = [func = std::forward<decltype(func)>(func)](
-                            can_frame frame) mutable {
-            func(static_cast<T>(frame));
-        };
-        lock_.lock();
-        for (auto id : can_ids) {
-            if (id >= 2048) {
-                return tl::unexpected(
-                    Error{ErrorCode::FuncCANIdSetError,
-                          std::format("CAN ID {} exceeds maximum limit of 2047",
-                                      id)});
-            }
-            funcs[id] = register_func;
+        requires(AnyCanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_func(const std::set<size_t> &can_ids, Func &&func,
+                  const Delivery delivery = Delivery::Inline) {
+        if (auto res = check_ids(can_ids); !res) {
+            return tl::unexpected(res.error());
+        }
+        Callback wrapped = make_callback<T>(std::forward<Func>(func));
+        CallbackHandle handle{};
+        return update_table([&](CallbackTable &table) {
+                   handle.id = ++next_handle_id;
+                   const Callback callback =
+                       delivery == Delivery::Deferred
+                           ? defer(std::move(wrapped), handle.id)
+                           : std::move(wrapped);
+                   for (auto id : can_ids) {
+                       subscribe(table, *to_table_key(id),
+                                 {callback, handle.id});
+                   }
+               })
+            .map([&] { return handle; });
+    }
+
+    // Like the above, and also runs freshness.on_timeout once an ID has
+    // gone freshness.deadline without a frame. The deadlines share one
+    // timerfd in the reap thread's epoll set; in Blocking mode they are
+    // only checked when a receive returns, at least every 100 ms. The
+    // watch ends with the callback.
+    template <typename T = can_frame, typename Func>
+        requires(AnyCanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_func(const std::set<size_t> &can_ids, Func &&func,
+                  const Freshness &freshness,
+                  const Delivery delivery = Delivery::Inline) {
+        return register_func<T>(can_ids, std::forward<Func>(func), delivery)
+            .and_then([&](const CallbackHandle handle)
+                          -> tl::expected<CallbackHandle, Error> {
+                if (auto res = watch(handle, can_ids, freshness); !res) {
+                    (void)unregister_handle(handle);
+                    return tl::unexpected(res.error());
+                }
+                return handle;
+            });
+    }
+
+    // Subscribes to blocks of IDs. Standard IDs and small extended blocks
+    // get a table entry per ID; larger extended blocks become id/mask
+    // entries tried only for extended IDs without an entry of their own.
+    // A frame matching several patterns of one call runs it once.
+    template <typename T = can_frame, typename Func>
+        requires(AnyCanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_func(const std::span<const IdPattern> patterns, Func &&func,
+                  const Delivery delivery = Delivery::Inline) {
+        const auto compiled = compile_id_patterns(patterns);
+        if (!compiled) {
+            return tl::unexpected(compiled.error());
         }
-        lock_.unlock();
-        return {};
+        Callback wrapped = make_callback<T>(std::forward<Func>(func));
+        CallbackHandle handle{};
+        return update_table([&](CallbackTable &table) {
+                   handle.id = ++next_handle_id;
+                   const Callback callback =
+                       delivery == Delivery::Deferred
+                           ? defer(std::move(wrapped), handle.id)
+                           : std::move(wrapped);
+                   for (const canid_t key : compiled->keys) {
+                       subscribe(table, key, {callback, handle.id});
+                   }
+                   for (const auto &[id, mask] : compiled->masks) {
+                       subscribe_mask(table, id, mask, {callback, handle.id});
+                   }
+               })
+            .map([&] { return handle; });
+    }
+
+    template <typename T = can_frame, typename Func>
+        requires(AnyCanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_func(const std::initializer_list<IdPattern> patterns, Func &&func,
+                  const Delivery delivery = Delivery::Inline) {
+        return register_func<T>(std::span(patterns.begin(), patterns.end()),
+                                std::forward<Func>(func), delivery);
+    }
+
+    // Like register_func, for remote transmission requests (CAN_RTR_FLAG)
+    // on these IDs. Only classic frames carry RTR.
+    template <typename T = can_frame, typename Func>
+        requires(CanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_remote_func(const std::set<size_t> &can_ids, Func &&func,
+                         const Delivery delivery = Delivery::Inline) {
+        if (auto res = check_ids(can_ids); !res) {
+            return tl::unexpected(res.error());
+        }
+        Callback wrapped = make_callback<T>(std::forward<Func>(func));
+        CallbackHandle handle{};
+        return update_side([&](SideTable &side) {
+                   handle.id = ++next_handle_id;
+                   const Callback callback =
+                       delivery == Delivery::Deferred
+                           ? defer(std::move(wrapped), handle.id)
+                           : std::move(wrapped);
+                   auto &keys = subscriptions[handle.id];
+                   for (auto id : can_ids) {
+                       const canid_t key = *to_table_key(id);
+                       side.remote[key].emplace_back(callback, handle.id);
+                       keys.push_back(key | CAN_RTR_FLAG);
+                   }
+               })
+            .map([&] { return handle; });
+    }
+
+    // Called with every error frame (CAN_ERR_FLAG) of the classes in
+    // DispatcherOptions::error_mask, after get_bus_errors() counted it.
+    // The error classes are in can_id, the details in data (see
+    // linux/can/error.h).
+    template <typename Func>
+        requires FrameHandler<Func, can_frame>
+    tl::expected<CallbackHandle, Error>
+    register_error_func(Func &&func,
+                        const Delivery delivery = Delivery::Inline) {
+        Callback wrapped = make_callback<can_frame>(std::forward<Func>(func));
+        CallbackHandle handle{};
+        return update_side([&](SideTable &side) {
+                   handle.id = ++next_handle_id;
+                   side.errors.emplace_back(
+                       delivery == Delivery::Deferred
+                           ? defer(std::move(wrapped), handle.id)
+                           : std::move(wrapped),
+                       handle.id);
+                   subscriptions[handle.id].push_back(CAN_ERR_FLAG);
+               })
+            .map([&] { return handle; });
+    }
+
+    // Removes every register_func callback registered for these IDs,
+    // leaving id/mask entries alone. Like every table update it does not
+    // wait for the reap thread, so a callback already running, or about to
+    // run for a frame being dispatched, may still finish after it returns.
+    tl::expected<void, Error> unregister_func(const std::set<size_t> &can_ids);
+    // Removes the callback of one register_*func call from all of its IDs.
+    // A template only so that a braced ID list never converts to a handle.
+    template <std::same_as<CallbackHandle> Handle>
+    tl::expected<void, Error> unregister_func(const Handle handle) {
+        return unregister_handle(handle);
     }
 
-#ifdef HYCAN_LATENCY_TEST
-    struct LatencyStats {
-        uint64_t total_latency_ns = 0;
-        uint64_t message_count = 0;
-        double average_latency_us = 0.0;
+    // Awaitable for the next data frame on `can_id`, in a Task running on
+    // an Executor; yields ReceiveTimeout once `timeout` has passed since
+    // this call (nanoseconds::max() waits for ever). Callbacks on the ID
+    // still run. The ID stays admitted by the kernel filter afterwards.
+    template <typename T = can_frame>
+        requires AnyCanFrameConvertible<T>
+    FrameAwaiter<T> receive(const size_t can_id,
+                            const std::chrono::nanoseconds timeout) {
+        return FrameAwaiter<T>(*this, can_id, timeout);
+    }
+
+    // Keeps the newest data frame of each ID in a Mailbox that any thread
+    // can read without locks, instead of running a callback per frame.
+    // Other callbacks on the IDs still run. Unregister with the mailbox's
+    // handle(); the mailbox stays readable but no longer updates.
+    tl::expected<std::shared_ptr<const Mailbox>, Error>
+    register_mailbox(const std::set<size_t> &can_ids);
+
+    struct ReceiveStats {
+        uint64_t wakeups = 0;          // drain passes over a readable socket
+        uint64_t receive_calls = 0;    // recvmmsg syscalls issued
+        uint64_t frames = 0;           // frames pulled from the socket
+        uint64_t budget_exhausted = 0; // drains cut short by wakeup_budget
+        uint64_t max_wakeup_frames = 0;
+        // Frames the kernel dropped because the receive queue was full.
+        uint64_t kernel_drops = 0;
+        // Bucket 0 counts empty wakeups, bucket k counts wakeups that
+        // drained [2^(k-1), 2^k) frames; the last bucket is open-ended.
+        std::array<uint64_t, DRAIN_HISTOGRAM_BUCKETS>
+            wakeup_frames_histogram{};
+    };
+
+    [[nodiscard]] ReceiveStats get_receive_stats() const noexcept;
+    // Receive buffer size as reported by the kernel (twice the request).
+    [[nodiscard]] tl::expected<int, Error>
+    get_receive_buffer() const noexcept {
+        return socket.receive_buffer_size();
+    }
+    struct StageTime {
+        uint64_t total_ns = 0;
+        uint64_t max_ns = 0;
+    };
+
+    // Where receive latency goes, per frame that had a callback. Only
+    // collected while receive timestamps are on (rx_timestamps, or while
+    // latency recording is enabled).
+    struct StageStats {
+        uint64_t frames = 0;
+        // Kernel receive until recvmmsg handed the frame to the reap thread;
+        // includes the epoll wakeup.
+        StageTime kernel_to_read;
+        // Until the frame's first callback started: earlier frames of the
+        // same batch and the table lookup.
+        StageTime read_to_callback;
+        // All callbacks of the frame, first start to last end.
+        StageTime callback;
     };
 
-    LatencyStats get_latency_stats() const;
-#endif
+    [[nodiscard]] StageStats get_stage_stats() const noexcept;
+
+    [[nodiscard]] BusErrorStats get_bus_errors() const noexcept {
+        return bus_errors.snapshot();
+    }
+
+    // One entry per deferred worker; empty until one has been started.
+    [[nodiscard]] std::vector<DeferredStats> get_deferred_stats() const;
+
+    // Start or stop recording, for every frame with a callback, the time
+    // from kernel receive to its first callback starting. Needs receive
+    // timestamps, which are turned on while recording. Costs a branch per
+    // frame while off.
+    tl::expected<void, Error> set_latency_recording(bool enabled);
+    // Over all IDs of this interface.
+    [[nodiscard]] Util::LatencySnapshot get_latency() const noexcept;
+    // Empty if the ID had no callback while recording was on.
+    [[nodiscard]] std::optional<Util::LatencySnapshot>
+    get_latency(size_t can_id) const;
+    // Exact only while recording is off.
+    void reset_latency();
+
+    // Per-ID data-frame traffic, including IDs without a callback that got
+    // past the kernel filter. Arrival times are kernel timestamps while
+    // receive timestamps are on; otherwise they are taken once per
+    // recvmmsg, so the jitter then also includes batching. Never blocks
+    // the reap thread.
+    [[nodiscard]] std::vector<IdTrafficStats> get_id_stats() const;
+    // Empty if the ID has not been seen or the table was full.
+    [[nodiscard]] std::optional<IdTrafficStats>
+    get_id_stats(size_t can_id) const;
 
   private:
+    friend class DispatcherGroup;
+    template <typename... Handlers> friend class StaticDispatcher;
+    friend class FrameWait;
+    friend class Mailbox;
+
+    using Callback = FrameCallback;
+    struct Subscriber {
+        Callback callback;
+        uint64_t handle_id;
+    };
+    // Subscribers of one ID, in registration order; a lone subscriber is
+    // stored inside the table entry itself.
+    struct Subscribers : Util::SmallVector<Subscriber, 1> {
+        // Per-ID histogram, set while latency recording is on.
+        Util::LatencyHistogram *latency = nullptr;
+        // Set once the ID has a freshness deadline.
+        Watchdog::Slot *fresh = nullptr;
+
+        explicit operator bool() const noexcept { return !empty(); }
+    };
+    using CallbackTable = DispatchTable<Subscribers>;
+    // Callbacks for rare frames, kept apart so data frames never look at
+    // them.
+    struct SideTable {
+        CallbackTable remote;
+        Subscribers errors;
+    };
+    // How often a blocking read wakes up to check for a stop request.
+    static constexpr std::chrono::milliseconds BLOCKING_STOP_CHECK{100};
+    // RCU reader slot used by the reap thread.
+    static constexpr size_t REAP_READER = 0;
+    // Frames between two receive-rate samples when auto-sizing.
+    static constexpr uint64_t AUTOSIZE_SAMPLE_FRAMES = 1024;
+    // Kernel memory charged per queued frame (its sk_buff truesize),
+    // roughly, on 64-bit kernels.
+    static constexpr uint64_t QUEUED_FRAME_BYTES = 768;
+
+    static std::optional<canid_t> to_table_key(size_t can_id) noexcept;
+    static tl::expected<void, Error>
+    check_ids(const std::set<size_t> &can_ids);
+    // Converts `func` to the table's callback type.
+    template <typename T, typename Func>
+    static Callback make_callback(Func &&func) {
+        // Stored inline in the table entry: one indirect call per frame and
+        // no heap allocation unless the captures outgrow the inline buffer.
+        return [func = std::forward<Func>(func)](
+                   const canfd_frame &frame,
+                   const RxTimestamp timestamp) mutable {
+            invoke_frame_handler<T>(func, frame, timestamp);
+        };
+    }
+    // Copy the table, apply `mutate`, publish it and resync the kernel filter.
+    tl::expected<void, Error>
+    update_table(const std::function<void(CallbackTable &)> &mutate);
+    // The same for the side table.
+    tl::expected<void, Error>
+    update_side(const std::function<void(SideTable &)> &mutate);
+    // A replaced table (one of the two is set), kept while the reap
+    // thread or a deferred task may still use it.
+    struct RetiredTables {
+        std::unique_ptr<CallbackTable> table;
+        std::unique_ptr<SideTable> side;
+        // RCU epoch the reap thread must move past.
+        uint64_t epoch;
+        // WorkerPool::marks() once it has, for the workers to pass.
+        std::optional<std::vector<uint64_t>> worker_marks{};
+    };
+    // Queues `old` and runs reclaim(); callers hold table_mutex_.
+    void retire(RetiredTables old);
+    // Frees the retired tables no thread can reach any more, without
+    // waiting for any; callers hold table_mutex_.
+    void reclaim();
+    // reclaim() for the reap thread, between drains: skipped while a
+    // writer holds the lock.
+    void try_reclaim();
+    // Admits every ID with a callback, a static handler or a receive()
+    // call; callers hold table_mutex_.
+    tl::expected<void, Error> sync_kernel_filter();
+    tl::expected<void, Error> unregister_handle(CallbackHandle handle);
+    // Starts the freshness watch of a register_func call.
+    tl::expected<void, Error> watch(CallbackHandle handle,
+                                    const std::set<size_t> &can_ids,
+                                    const Freshness &freshness);
+    // Wraps `callback` to run on a worker; starts the pool if needed.
+    Callback defer(Callback callback, uint64_t handle_id);
+    // Drops `key` from a handle's bookkeeping once its callback is gone.
+    void forget_subscription(uint64_t handle_id, canid_t key);
+    // Adds `subscriber` under `key`. A new extended entry starts with the
+    // subscribers of the id/mask entries covering it, so the hash hit
+    // alone finds every callback.
+    void subscribe(CallbackTable &table, canid_t key,
+                   const Subscriber &subscriber);
+    // Adds `subscriber` for an extended id/mask block. The mask entries
+    // stay closed under intersection, and each holds the subscribers of
+    // every block containing it, so a frame's first (most specific)
+    // match is complete.
+    void subscribe_mask(CallbackTable &table, canid_t id, canid_t mask,
+                        const Subscriber &subscriber);
+
+    struct DrainResult {
+        size_t frames;
+        bool empty; // the receive queue was emptied
+        int error;  // errno of a failed recvmmsg that ended it, else 0
+    };
+
+    // Real-time priority, pinning and memory locking for a reap thread.
+    static void prepare_reap_thread(uint8_t cpu_core);
+    // Next core in the round-robin used when none is given.
+    static uint8_t next_cpu_core();
+    // Normalizes the batch options, sizes the recvmmsg buffers and sets
+    // up the receive-side socket options and statistics.
+    void init_rx_buffers();
+
     void reap_process(const std::stop_token &stop_token);
-    tl::expected<void, Error> epoll_fd_add_sock_fd(int sock_fd) const noexcept;
+    void epoll_loop(const std::stop_token &stop_token);
+    void blocking_loop(const std::stop_token &stop_token);
+    void spin_loop(const std::stop_token &stop_token);
+    // Keep polling until no frame arrived for options.spin_window.
+    void spin_window(const std::stop_token &stop_token);
+    // `flags` apply to the first recvmmsg only; empty polls are not
+    // counted as wakeups unless `record_empty` is set.
+    DrainResult drain(int fd, int flags = MSG_DONTWAIT,
+                      bool record_empty = true);
+    void record_drain(size_t frames, bool budget_hit);
+    // Applies options.auto_receive_buffer after a drain.
+    void autosize_receive_buffer(bool dropped);
+    void dispatch(CallbackTable &table, const canfd_frame &frame,
+                  RxTimestamp timestamp);
+    void record_traffic(const canfd_frame &frame, RxTimestamp timestamp,
+                        bool delivered);
+    // receive() bookkeeping. add_waiter admits the ID in the kernel
+    // filter; remove_waiter returns whether `wait` was still listening.
+    tl::expected<void, Error> add_waiter(FrameWait &wait, size_t can_id);
+    bool remove_waiter(FrameWait &wait);
+    // Counted per key; the filter widens on the first await of a key and
+    // narrows again once none is left.
+    tl::expected<void, Error> admit_awaited(canid_t key);
+    void release_awaited(canid_t key);
+    // Hands `frame` to the receive() calls listening for it.
+    void wake_waiters(const canfd_frame &frame);
+    // Error and remote frames.
+    void dispatch_side(const canfd_frame &frame, RxTimestamp timestamp);
+    void record_timing(const Subscribers &subscribers, RxTimestamp timestamp,
+                       RxTimestamp started, RxTimestamp finished);
+    // Points every table entry at its ID's histogram, creating missing ones.
+    void attach_histograms(CallbackTable &table);
+    tl::expected<void, Error>
+    epoll_fd_add_sock_fd(int sock_fd, uint32_t events = EPOLLIN) const noexcept;
 
     Socket socket;
+    DispatcherOptions options;
     int thread_event_fd{-1};
     int epoll_fd{-1};
     uint8_t cpu_core{};
-    std::function<void(can_frame)> funcs[HC_MAX_STD_CAN_ID]{};
+    // Set when the sockets are served by a shared group thread.
+    DispatcherGroup *group{nullptr};
+    // Read lock-free by the reap thread; writers serialize on table_mutex_.
+    Util::RcuPtr<CallbackTable> funcs{std::make_unique<CallbackTable>()};
+    Util::RcuPtr<SideTable> side_funcs{std::make_unique<SideTable>()};
+    // Compile-time handlers tried before the table, set by a
+    // StaticDispatcher before the reap thread exists. Returns whether the
+    // frame's ID had one.
+    bool (*static_route)(const canfd_frame &, RxTimestamp){nullptr};
+    // The table keys they handle, admitted by the kernel filter.
+    std::span<const canid_t> static_keys;
+    // Freshness deadlines; its timerfd joins the reap thread's epoll set.
+    Watchdog watchdog;
+    // Pending receive() calls; the reap thread only takes the lock while
+    // `waiting` is non-zero.
+    Util::SpinLock waiter_lock;
+    std::vector<FrameWait *> waiters;
+    std::atomic<size_t> waiting{0};
+    // Keys of live receive() calls and how many there are of each. Taken
+    // after table_mutex_ when both are held.
+    std::mutex awaited_mutex_;
+    std::unordered_map<canid_t, size_t> awaited_keys;
     std::string_view interface_name;
     std::jthread reap_thread;
-    Util::SpinLock lock_;
+    mutable std::mutex table_mutex_;
+    // Writer-side bookkeeping, guarded by table_mutex_: the keys each
+    // handle was registered under. Remote keys carry CAN_RTR_FLAG; an
+    // error callback has the single key CAN_ERR_FLAG.
+    std::unordered_map<uint64_t, std::vector<canid_t>> subscriptions;
+    // Handles with id/mask entries; their callbacks may also have been
+    // copied into extended entries they cover.
+    std::unordered_set<uint64_t> mask_handles;
+    uint64_t next_handle_id{0};
+    // Guarded by table_mutex_; `retire_pending` mirrors its non-emptiness
+    // for the reap thread.
+    std::vector<RetiredTables> retired;
+    std::atomic<bool> retire_pending{false};
+    // Created under table_mutex_; declared after `funcs` and `retired` so
+    // the workers are joined before the tables their tasks point into are
+    // freed.
+    std::unique_ptr<WorkerPool> workers;
+
+    // Preallocated recvmmsg buffers, sized to options.batch_size.
+    std::vector<canfd_frame> rx_frames;
+    std::vector<iovec> rx_iovecs;
+    std::vector<mmsghdr> rx_msgs;
+    // Whether frames are passed their receive timestamp. The socket also
+    // delivers timestamps while `traffic` is set, for the per-ID stats
+    // alone.
+    std::atomic<bool> rx_stamping{false};
+    // Control-message space for SO_TIMESTAMPNS and SO_RXQ_OVFL, one per
+    // message.
+    union RxControl {
+        cmsghdr align;
+        char buffer[CMSG_SPACE(sizeof(timespec)) +
+                    CMSG_SPACE(sizeof(uint32_t))];
+    };
+    std::vector<RxControl> rx_control;
+    // When the last recvmmsg returned; only kept while rx_stamping or
+    // `traffic` is set.
+    RxTimestamp rx_read_at{};
+    // Kernel timestamp of the frame being dispatched; zero when the socket
+    // does not deliver timestamps.
+    RxTimestamp rx_arrival{};
+    // Null when options.id_stats_capacity is 0.
+    std::unique_ptr<TrafficStats> traffic;
+    // SO_RXQ_OVFL count of the current socket as of the last frame.
+    uint32_t socket_drops_seen{0};
+    // Auto-sizing state: the requested buffer size, and the frame count
+    // and time of the last rate sample.
+    int receive_buffer_bytes{0};
+    uint64_t autosize_frames{0};
+    std::chrono::steady_clock::time_point autosize_since{};
+
+    uint64_t drain_receive_calls{0};
+    std::atomic<uint64_t> stat_wakeups{0};
+    std::atomic<uint64_t> stat_receive_calls{0};
+    std::atomic<uint64_t> stat_frames{0};
+    std::atomic<uint64_t> stat_budget_exhausted{0};
+    std::atomic<uint64_t> stat_max_wakeup_frames{0};
+    std::atomic<uint64_t> stat_kernel_drops{0};
+    BusErrorCounters bus_errors;
+    std::array<std::atomic<uint64_t>, DRAIN_HISTOGRAM_BUCKETS>
+        stat_drain_histogram{};
+    // Indexed like StageStats: kernel_to_read, read_to_callback, callback.
+    std::atomic<uint64_t> stat_stage_frames{0};
+    std::array<std::atomic<uint64_t>, 3> stat_stage_total_ns{};
+    std::array<std::atomic<uint64_t>, 3> stat_stage_max_ns{};
 
-#ifdef HYCAN_LATENCY_TEST
-    mutable std::atomic<uint64_t> accumulated_latency_ns{0};
-    mutable std::atomic<uint64_t> latency_message_count{0};
-#endif
+    std::atomic<bool> latency_recording{false};
+    Util::LatencyHistogram latency_histogram;
+    // Guarded by table_mutex_; entries live as long as the dispatcher, so
+    // table entries can point at them.
+    std::unordered_map<canid_t, std::unique_ptr<Util::LatencyHistogram>>
+        latency_by_id;
 };
 } // namespace HyCAN
 
@@ -0,0 +1,61 @@
+#ifndef HYCAN_DISPATCHER_GROUP_HPP
+#define HYCAN_DISPATCHER_GROUP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <tl/expected.hpp>
+
+#include "HyCAN/Util/Error.hpp"
+
+namespace HyCAN {
+class Dispatcher;
+
+/**
+ * @brief One reap thread shared by several interfaces.
+ *
+ * Dispatchers constructed with a group do not start a thread of their own:
+ * on start() their socket and watchdog timer join the group's epoll set,
+ * and the group's thread drains each readable socket into that
+ * dispatcher's own table, up to its wakeup_budget per pass so a busy bus
+ * cannot starve the others.
+ * The thread is started on the first attach and pinned like a dedicated
+ * reap thread.
+ *
+ * The group must outlive every dispatcher attached to it.
+ */
+class DispatcherGroup {
+  public:
+    explicit DispatcherGroup(
+        const std::optional<uint8_t> &cpu_core_opt = std::nullopt);
+    DispatcherGroup(const DispatcherGroup &) = delete;
+    DispatcherGroup &operator=(const DispatcherGroup &) = delete;
+    ~DispatcherGroup();
+
+    // Number of dispatchers currently attached.
+    [[nodiscard]] size_t size() const;
+
+  private:
+    friend class Dispatcher;
+
+    tl::expected<void, Error> attach(Dispatcher &dispatcher);
+    // Once this returns, the group thread no longer touches `dispatcher`.
+    tl::expected<void, Error> detach(Dispatcher &dispatcher);
+    void reap_process(const std::stop_token &stop_token);
+
+    int epoll_fd{-1};
+    int thread_event_fd{-1};
+    uint8_t cpu_core{};
+    mutable std::mutex mutex_;
+    std::vector<Dispatcher *> members;
+    // Completed epoll_wait passes; detach() waits for it to move on.
+    std::atomic<uint64_t> passes{0};
+    std::jthread reap_thread;
+};
+} // namespace HyCAN
+
+#endif // HYCAN_DISPATCHER_GROUP_HPP
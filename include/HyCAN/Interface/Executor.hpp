@@ -0,0 +1,290 @@
+#ifndef HYCAN_EXECUTOR_HPP
+#define HYCAN_EXECUTOR_HPP
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <list>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <tl/expected.hpp>
+
+#include "HyCAN/Util/Error.hpp"
+#include "HyCAN/Util/SpinLock.hpp"
+
+namespace HyCAN {
+class Executor;
+
+// Promise parts shared by every Task.
+struct TaskPromiseBase {
+    struct FinalAwaiter {
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<>
+        await_suspend(const std::coroutine_handle<Promise> handle) noexcept {
+            return handle.promise().complete(handle);
+        }
+        void await_resume() const noexcept {}
+    };
+
+    [[nodiscard]] std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+    [[nodiscard]] FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+    // Where control goes once the body has finished: to the awaiting
+    // coroutine, or back to the executor of a spawned task, which frees it.
+    std::coroutine_handle<> complete(std::coroutine_handle<> self) noexcept;
+
+    std::coroutine_handle<> continuation;
+    // Set once the task is spawned; the executor then owns it.
+    Executor *owner = nullptr;
+    std::exception_ptr exception;
+};
+
+template <typename T> struct TaskPromise : TaskPromiseBase {
+    template <typename U = T> void return_value(U &&value) {
+        result.emplace(std::forward<U>(value));
+    }
+
+    std::optional<T> result;
+};
+
+template <> struct TaskPromise<void> : TaskPromiseBase {
+    void return_void() const noexcept {}
+};
+
+/**
+ * @brief A coroutine producing a T, started when first awaited or spawned.
+ *
+ * Awaiting a task runs it to completion on the awaiting thread before the
+ * awaiting coroutine resumes; exceptions propagate to the awaiter.
+ */
+template <typename T = void> class [[nodiscard]] Task {
+  public:
+    struct promise_type : TaskPromise<T> {
+        Task get_return_object() noexcept {
+            return Task(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<>
+    await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() {
+        auto &promise = handle.promise();
+        if (promise.exception) {
+            std::rethrow_exception(promise.exception);
+        }
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*promise.result);
+        }
+    }
+
+  private:
+    friend class Executor;
+
+    explicit Task(const std::coroutine_handle<promise_type> handle) noexcept
+        : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * @brief Runs Tasks on the thread that calls run().
+ *
+ * A single-threaded loop over one epoll set: coroutines another thread
+ * hands back with post() (the reap thread does when an awaited frame
+ * arrives) and timer deadlines (a timerfd) wake it, socket writability
+ * resumes send_async. No thread is started for any await, and post()
+ * only writes the wakeup eventfd while the loop is asleep.
+ */
+class Executor {
+  public:
+    using Clock = std::chrono::steady_clock;
+    // Called on the executor thread; `ready` is false when the deadline
+    // came first.
+    using Wakeup = void (*)(void *context, bool ready);
+
+    struct Timer {
+        Wakeup wakeup;
+        void *context;
+    };
+    using TimerId = std::multimap<Clock::time_point, Timer>::iterator;
+
+    Executor();
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+    // Destroys the spawned tasks that have not finished.
+    ~Executor();
+
+    // Hands `task` to the executor, which starts it from run(). Any thread.
+    template <typename T> void spawn(Task<T> task) {
+        const auto handle = std::exchange(task.handle, {});
+        handle.promise().owner = this;
+        {
+            std::lock_guard guard(ready_lock);
+            tasks.insert(handle.address());
+            ready.push_back(handle);
+        }
+        wake();
+    }
+
+    // Runs tasks on the calling thread until every spawned task finished
+    // or stop() was called. Rethrows the first exception a spawned task
+    // let escape.
+    tl::expected<void, Error> run();
+    // Makes run() return after the current step. Any thread.
+    void stop() noexcept;
+    // Resumes `handle` on the executor thread. Any thread.
+    void post(std::coroutine_handle<> handle);
+
+    // The executor running on the calling thread, if any.
+    [[nodiscard]] static Executor *current() noexcept;
+
+    class SleepAwaiter;
+    // Awaitable resuming the caller after `duration`.
+    [[nodiscard]] static SleepAwaiter
+    sleep_for(std::chrono::nanoseconds duration);
+
+    // Building blocks for awaitables; executor thread only.
+    // Calls wakeup(context, false) at `deadline`. A timer is gone once it
+    // fired; cancel it before that.
+    TimerId add_timer(Clock::time_point deadline, Wakeup wakeup,
+                      void *context);
+    void cancel_timer(TimerId timer);
+    // Calls wakeup(context, true) once `fd` is writable, or
+    // wakeup(context, false) at `deadline`, whichever comes first.
+    tl::expected<void, Error> wait_writable(int fd,
+                                            Clock::time_point deadline,
+                                            Wakeup wakeup, void *context);
+    // Drops a pending wait_writable before it fired.
+    void cancel_writable(void *context);
+
+  private:
+    friend struct TaskPromiseBase;
+
+    struct FdWait {
+        int fd;
+        Wakeup wakeup;
+        void *context;
+        std::optional<TimerId> timer;
+    };
+
+    static void writable_expired(void *context, bool ready);
+    // Frees a finished spawned task.
+    void finish(std::coroutine_handle<> task,
+                const std::exception_ptr &exception) noexcept;
+    void wake() noexcept;
+    // Sleeps in epoll_wait unless coroutines are ready, then handles what
+    // woke it.
+    tl::expected<void, Error> wait_events();
+    void fire_timers();
+    void fire_writable(int fd);
+    // Removes `wait` and its epoll registration if it was the fd's last.
+    void drop_fd_wait(std::list<FdWait>::iterator wait);
+
+    int epoll_fd{-1};
+    int wake_fd{-1};
+    int timer_fd{-1};
+    std::atomic<bool> stop_requested{false};
+    // Set while run() may block in epoll_wait.
+    std::atomic<bool> sleeping{false};
+    // Guards `ready` and `tasks`, which other threads post to.
+    Util::SpinLock ready_lock;
+    std::vector<std::coroutine_handle<>> ready;
+    std::unordered_set<void *> tasks;
+    std::exception_ptr failure;
+    // Executor thread only.
+    std::multimap<Clock::time_point, Timer> timers;
+    Clock::time_point armed_deadline{Clock::time_point::max()};
+    std::list<FdWait> fd_waits;
+};
+
+class Executor::SleepAwaiter {
+  public:
+    explicit SleepAwaiter(const Clock::time_point deadline) noexcept
+        : deadline(deadline) {}
+    SleepAwaiter(const SleepAwaiter &) = delete;
+    SleepAwaiter &operator=(const SleepAwaiter &) = delete;
+    ~SleepAwaiter() {
+        if (timer) {
+            executor->cancel_timer(*timer);
+        }
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept {
+        return deadline <= Clock::now();
+    }
+    bool await_suspend(const std::coroutine_handle<> handle) {
+        executor = current();
+        if (!executor) {
+            return false;
+        }
+        this->handle = handle;
+        timer = executor->add_timer(deadline, &SleepAwaiter::expire, this);
+        return true;
+    }
+    void await_resume() const noexcept {}
+
+  private:
+    static void expire(void *self, bool) {
+        auto &awaiter = *static_cast<SleepAwaiter *>(self);
+        awaiter.timer.reset();
+        awaiter.handle.resume();
+    }
+
+    Clock::time_point deadline;
+    Executor *executor{nullptr};
+    std::coroutine_handle<> handle;
+    std::optional<TimerId> timer;
+};
+
+inline Executor::SleepAwaiter
+Executor::sleep_for(const std::chrono::nanoseconds duration) {
+    return SleepAwaiter(Clock::now() + duration);
+}
+
+inline std::coroutine_handle<>
+TaskPromiseBase::complete(const std::coroutine_handle<> self) noexcept {
+    if (continuation) {
+        return continuation;
+    }
+    if (owner) {
+        owner->finish(self, exception);
+    }
+    return std::noop_coroutine();
+}
+} // namespace HyCAN
+
+#endif // HYCAN_EXECUTOR_HPP
@@ -20,7 +20,8 @@ namespace HyCAN
         static IPCManager& instance();
 
         // Core interface operations
-        tl::expected<void, Error> set(std::string_view interface_name, bool up, uint32_t bitrate = 1000000);
+        tl::expected<void, Error> set(std::string_view interface_name, bool up, uint32_t bitrate = 1000000,
+                                      uint32_t data_bitrate = 0);
         tl::expected<bool, Error> exists(std::string_view interface_name);
         tl::expected<bool, Error> is_up(std::string_view interface_name);
         tl::expected<void, Error> create_vcan(std::string_view interface_name);
@@ -0,0 +1,57 @@
+#ifndef HYCAN_ID_PATTERN_HPP
+#define HYCAN_ID_PATTERN_HPP
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <HyCAN/Util/Error.hpp>
+#include <linux/can.h>
+#include <tl/expected.hpp>
+
+namespace HyCAN {
+/**
+ * @brief A block of CAN IDs to subscribe to in one go.
+ *
+ * Either an inclusive range, or every ID whose bits under `mask` equal
+ * those of `id`. As with single IDs, values above 0x7FF or carrying
+ * CAN_EFF_FLAG are extended IDs; a range may not mix both kinds.
+ */
+struct IdPattern {
+    static constexpr IdPattern range(const size_t first, const size_t last) {
+        return {first, last, 0, false};
+    }
+
+    static constexpr IdPattern match(const size_t id, const canid_t mask) {
+        return {id, 0, mask, true};
+    }
+
+    size_t id;
+    size_t last;  // range only
+    canid_t mask; // mask only
+    bool masked;
+
+  private:
+    // Not an aggregate, so a braced list of IDs never reads as a pattern.
+    constexpr IdPattern(const size_t id, const size_t last,
+                        const canid_t mask, const bool masked)
+        : id(id), last(last), mask(mask), masked(masked) {}
+};
+
+// Patterns lowered for the dispatch table.
+struct CompiledIdPatterns {
+    // Table keys, one per ID: every standard ID, and extended blocks of
+    // up to 2^MAX_EXPANDED_BITS IDs.
+    std::vector<canid_t> keys;
+    // Larger extended blocks as 29-bit id/mask pairs.
+    std::vector<std::pair<canid_t, canid_t>> masks;
+
+    static constexpr unsigned MAX_EXPANDED_BITS = 8;
+};
+
+tl::expected<CompiledIdPatterns, Error>
+compile_id_patterns(std::span<const IdPattern> patterns);
+} // namespace HyCAN
+
+#endif // HYCAN_ID_PATTERN_HPP
@@ -2,9 +2,14 @@
 #define INTERFACE_HPP
 
 #include "CanFrameConvertible.hpp"
+#include "CyclicSender.hpp"
 #include "Dispatcher.hpp"
+#include "Mailbox.hpp"
 #include "Sender.hpp"
+#include "TxQueue.hpp"
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -13,33 +18,270 @@ enum class InterfaceType { CAN, VCAN };
 
 template <InterfaceType Type = InterfaceType::CAN> class Interface {
   public:
-    explicit Interface(const std::string &interface_name, const std::optional<uint8_t>& cpu_core_opt = std::nullopt);
+    explicit Interface(const std::string &interface_name,
+                       const std::optional<uint8_t> &cpu_core_opt = std::nullopt,
+                       const DispatcherOptions &dispatcher_options = {});
+    // Receive on `group`'s shared thread instead of a dedicated one.
+    Interface(const std::string &interface_name, DispatcherGroup &group,
+              const DispatcherOptions &dispatcher_options = {});
     Interface() = delete;
-    tl::expected<void, Error> up(uint32_t bitrate = 1000000);
+    // A non-zero data_bitrate enables CAN FD with bit rate switching.
+    tl::expected<void, Error> up(uint32_t bitrate = 1000000,
+                                 uint32_t data_bitrate = 0);
     tl::expected<void, Error> down();
     tl::expected<bool, Error> exists();
     tl::expected<bool, Error> is_up();
 
-    template <CanFrameConvertible T> tl::expected<void, Error> send(T frame) {
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error> send(T frame) {
         return sender.send(frame);
     };
 
+    // Waits up to `timeout` for room instead of yielding
+    // CANSocketBufferFull at once; see Sender::send_blocking.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error>
+    send_blocking(T frame, const std::chrono::nanoseconds timeout,
+                  const std::chrono::nanoseconds spin = Sender::DEFAULT_SPIN) {
+        return sender.send_blocking(frame, timeout, spin);
+    }
+
+    [[nodiscard]] SendBlockStats get_send_block_stats() const noexcept {
+        return sender.get_block_stats();
+    }
+
+    // One sendmmsg per chunk of frames; see Sender::send_batch. Pass T
+    // explicitly to send from a container: send_batch<can_frame>(frames).
+    template <AnyCanFrameConvertible T>
+    BatchSendResult send_batch(const std::span<const T> frames) {
+        return sender.send_batch(frames);
+    }
+
+    // Starts the queued TX mode: enqueue() may then be called from any
+    // number of threads, and a TX thread with a socket of its own sends
+    // the frames. Call it before the first enqueue(). send() and
+    // send_batch() are unaffected, and still not thread-safe.
+    void enable_tx_queue(const TxQueueOptions &options = {}) {
+        tx_queue = std::make_unique<TxQueue>(interface_name, options);
+    }
+
+    // Queues the frame for the TX thread without a syscall; see TxQueue.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error> enqueue(const T &frame) noexcept {
+        if (!tx_queue) {
+            return tl::make_unexpected(Error{ErrorCode::TxQueueNotEnabled,
+                                             "TX queue not enabled"});
+        }
+        return tx_queue->enqueue(frame);
+    }
+
+    // Waits up to `timeout` for the TX thread to send or drop every queued
+    // frame; returns whether it did. See TxQueue::flush.
+    bool flush_tx_queue(const std::chrono::nanoseconds timeout) const {
+        return !tx_queue || tx_queue->flush(timeout);
+    }
+
+    // Empty until enable_tx_queue().
+    [[nodiscard]] std::optional<TxQueueStats> get_tx_queue_stats() const {
+        if (!tx_queue) {
+            return std::nullopt;
+        }
+        return tx_queue->stats();
+    }
+
+    // The kernel sends `frame` every `period` until stop_cyclic(), with no
+    // thread of ours involved; see CyclicSender.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error>
+    start_cyclic(const T &frame, const std::chrono::microseconds period) {
+        return cyclic_sender.start(frame, period);
+    }
+
+    // Swaps the payload of a cyclic frame without touching its period.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error> update_cyclic(const T &frame,
+                                            const bool announce = false) {
+        return cyclic_sender.update(frame, announce);
+    }
+
+    tl::expected<void, Error> stop_cyclic(const canid_t can_id) {
+        return cyclic_sender.stop(can_id);
+    }
+
+    // Has the kernel report frames on mask.can_id whose bits under `mask`
+    // changed, and silence of `timeout`; see CyclicSender::watch.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error>
+    watch_cyclic(const T &mask, const std::chrono::microseconds timeout = {},
+                 const std::chrono::microseconds throttle = {}) {
+        return cyclic_sender.watch(mask, timeout, throttle);
+    }
+
+    tl::expected<void, Error> unwatch_cyclic(const canid_t can_id) {
+        return cyclic_sender.unwatch(can_id);
+    }
+
+    // Next report of watch_cyclic(), or nullopt; never blocks.
+    tl::expected<std::optional<CyclicEvent>, Error>
+    read_cyclic_event() noexcept {
+        return cyclic_sender.read_event();
+    }
+
+    // Readable while read_cyclic_event() has a report; -1 before the first
+    // cyclic or watched frame.
+    [[nodiscard]] int get_cyclic_sock_fd() const {
+        return cyclic_sender.get_sock_fd();
+    }
+
+    // co_await in a Task running on an Executor. Yields
+    // CANSocketBufferFull if the socket stays full for `timeout`.
+    template <AnyCanFrameConvertible T>
+    SendAwaiter<T>
+    send_async(T frame, const std::chrono::nanoseconds timeout =
+                            std::chrono::milliseconds(100)) {
+        return sender.send_async(std::move(frame), timeout);
+    }
+
+    // co_await in a Task running on an Executor for the next frame on
+    // `can_id`; see Dispatcher::receive. Create it before sending the
+    // request it answers, so an early reply is not missed.
+    template <typename T = can_frame>
+        requires AnyCanFrameConvertible<T>
+    FrameAwaiter<T> receive(const size_t can_id,
+                            const std::chrono::nanoseconds timeout) {
+        return dispatcher.receive<T>(can_id, timeout);
+    }
+
+    template <typename T = can_frame, typename Func>
+        requires(AnyCanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_callback(const std::set<size_t> &can_ids, Func &&func,
+                      const Delivery delivery = Delivery::Inline) {
+        return dispatcher.register_func<T>(can_ids, func, delivery);
+    }
+
+    // Also runs freshness.on_timeout when an ID goes quiet for longer
+    // than freshness.deadline; see Dispatcher::register_func.
+    template <typename T = can_frame, typename Func>
+        requires(AnyCanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_callback(const std::set<size_t> &can_ids, Func &&func,
+                      const Freshness &freshness,
+                      const Delivery delivery = Delivery::Inline) {
+        return dispatcher.register_func<T>(can_ids, func, freshness,
+                                           delivery);
+    }
+
     template <typename T = can_frame, typename Func>
-        requires(CanFrameConvertible<T> && std::invocable<Func, T>)
-    tl::expected<void, Error> register_callback(const std::set<size_t> &can_ids,
-                                                Func &&func) {
-        return dispatcher.register_func<T>(can_ids, func);
+        requires(AnyCanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_callback(const std::span<const IdPattern> patterns, Func &&func,
+                      const Delivery delivery = Delivery::Inline) {
+        return dispatcher.register_func<T>(patterns, func, delivery);
     }
-#ifdef HYCAN_LATENCY_TEST
-    Dispatcher::LatencyStats get_reaper_latency_stats() const {
-        return dispatcher.get_latency_stats();
+
+    template <typename T = can_frame, typename Func>
+        requires(AnyCanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_callback(const std::initializer_list<IdPattern> patterns,
+                      Func &&func,
+                      const Delivery delivery = Delivery::Inline) {
+        return dispatcher.register_func<T>(patterns, func, delivery);
+    }
+
+    template <typename T = can_frame, typename Func>
+        requires(CanFrameConvertible<T> && FrameHandler<Func, T>)
+    tl::expected<CallbackHandle, Error>
+    register_remote_callback(const std::set<size_t> &can_ids, Func &&func,
+                             const Delivery delivery = Delivery::Inline) {
+        return dispatcher.register_remote_func<T>(can_ids, func, delivery);
+    }
+
+    template <typename Func>
+        requires FrameHandler<Func, can_frame>
+    tl::expected<CallbackHandle, Error>
+    register_error_callback(Func &&func,
+                            const Delivery delivery = Delivery::Inline) {
+        return dispatcher.register_error_func(func, delivery);
+    }
+
+    // Latest frame per ID, readable from any thread without locks; see
+    // Dispatcher::register_mailbox.
+    tl::expected<std::shared_ptr<const Mailbox>, Error>
+    register_mailbox(const std::set<size_t> &can_ids) {
+        return dispatcher.register_mailbox(can_ids);
+    }
+
+    tl::expected<void, Error>
+    unregister_callback(const std::set<size_t> &can_ids) {
+        return dispatcher.unregister_func(can_ids);
+    }
+
+    template <std::same_as<CallbackHandle> Handle>
+    tl::expected<void, Error> unregister_callback(const Handle handle) {
+        return dispatcher.unregister_func(handle);
+    }
+
+    [[nodiscard]] Dispatcher::ReceiveStats get_receive_stats() const noexcept {
+        return dispatcher.get_receive_stats();
+    }
+
+    // Kernel-reported size; the requested size comes from
+    // DispatcherOptions::receive_buffer.
+    [[nodiscard]] tl::expected<int, Error> get_receive_buffer() const noexcept {
+        return dispatcher.get_receive_buffer();
+    }
+
+    tl::expected<void, Error> set_send_buffer(const int bytes) noexcept {
+        return sender.set_send_buffer(bytes);
+    }
+
+    [[nodiscard]] tl::expected<int, Error> get_send_buffer() const noexcept {
+        return sender.get_send_buffer();
+    }
+
+    [[nodiscard]] BusErrorStats get_bus_errors() const noexcept {
+        return dispatcher.get_bus_errors();
+    }
+
+    [[nodiscard]] Dispatcher::StageStats get_stage_stats() const noexcept {
+        return dispatcher.get_stage_stats();
+    }
+
+    [[nodiscard]] std::vector<DeferredStats> get_deferred_stats() const {
+        return dispatcher.get_deferred_stats();
+    }
+
+    tl::expected<void, Error> set_latency_recording(const bool enabled) {
+        return dispatcher.set_latency_recording(enabled);
+    }
+
+    [[nodiscard]] Util::LatencySnapshot get_latency() const noexcept {
+        return dispatcher.get_latency();
+    }
+
+    [[nodiscard]] std::optional<Util::LatencySnapshot>
+    get_latency(const size_t can_id) const {
+        return dispatcher.get_latency(can_id);
+    }
+
+    void reset_latency() { dispatcher.reset_latency(); }
+
+    [[nodiscard]] std::vector<IdTrafficStats> get_id_stats() const {
+        return dispatcher.get_id_stats();
+    }
+
+    [[nodiscard]] std::optional<IdTrafficStats>
+    get_id_stats(const size_t can_id) const {
+        return dispatcher.get_id_stats(can_id);
     }
-#endif
 
   private:
     std::string interface_name;
     Dispatcher dispatcher;
     Sender sender;
+    CyclicSender cyclic_sender;
+    std::unique_ptr<TxQueue> tx_queue;
 };
 
 // Type aliases for common usage
@@ -0,0 +1,77 @@
+#ifndef HYCAN_MAILBOX_HPP
+#define HYCAN_MAILBOX_HPP
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <linux/can.h>
+
+#include "Dispatcher.hpp"
+#include "HyCAN/Util/SeqLock.hpp"
+
+namespace HyCAN {
+// The newest frame of one ID.
+struct MailboxSample {
+    canfd_frame frame;
+    // Kernel receive time while receive timestamps are on, otherwise when
+    // the reap thread handled the frame.
+    RxTimestamp timestamp;
+    // Frames received on the ID so far. Unchanged since the last read
+    // means stale; a jump of more than one means frames were overwritten
+    // unread.
+    uint64_t sequence;
+};
+
+/**
+ * @brief Latest-value store: one seqlock slot per ID.
+ *
+ * Filled by the reap thread (see Dispatcher::register_mailbox) and read by
+ * any thread without locks or syscalls, for control loops that poll at
+ * their own rate instead of taking callbacks.
+ */
+class Mailbox {
+  public:
+    // `keys` are dispatch table keys, sorted and unique.
+    explicit Mailbox(std::span<const canid_t> keys);
+
+    // Empty if the ID is not in the mailbox or has had no frame yet.
+    [[nodiscard]] std::optional<MailboxSample>
+    read(size_t can_id) const noexcept;
+    // Frames received on the ID so far: a cheap check for news before
+    // read(). 0 if the ID is not in the mailbox.
+    [[nodiscard]] uint64_t sequence(size_t can_id) const noexcept;
+    // Pass to Dispatcher::unregister_func to stop filling the mailbox.
+    [[nodiscard]] CallbackHandle handle() const noexcept {
+        return handle_;
+    }
+
+  private:
+    friend class Dispatcher;
+
+    struct Value {
+        canfd_frame frame;
+        RxTimestamp timestamp;
+    };
+    // One cache line apart, so a reader polling one ID never contends
+    // with the writer of another.
+    struct alignas(64) Slot {
+        Util::SeqLock<Value> value;
+    };
+
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    // Index of the ID's slot, or NOT_FOUND.
+    [[nodiscard]] size_t find(size_t can_id) const noexcept;
+    // Reap thread only.
+    void write(const canfd_frame &frame, RxTimestamp timestamp) noexcept;
+
+    std::vector<canid_t> keys;
+    std::unique_ptr<Slot[]> slots;
+    CallbackHandle handle_{};
+};
+} // namespace HyCAN
+
+#endif // HYCAN_MAILBOX_HPP
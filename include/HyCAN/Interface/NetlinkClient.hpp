@@ -20,10 +20,12 @@ namespace HyCAN
     public:
         tl::expected<void, Error> ensure_registered();
         tl::expected<NetlinkResponse, Error> send_request(const NetlinkRequest& request);
-        static tl::expected<void, Error> fallback_system_call(std::string_view interface_name, bool state, uint32_t bitrate = 1000000);
+        static tl::expected<void, Error> fallback_system_call(std::string_view interface_name, bool state, uint32_t bitrate = 1000000,
+                                                              uint32_t data_bitrate = 0);
 
         // Interface operations
-        tl::expected<void, Error> set_interface_state(std::string_view interface_name, bool up, uint32_t bitrate = 1000000);
+        tl::expected<void, Error> set_interface_state(std::string_view interface_name, bool up, uint32_t bitrate = 1000000,
+                                                      uint32_t data_bitrate = 0);
         tl::expected<bool, Error> interface_exists(std::string_view interface_name);
         tl::expected<bool, Error> interface_is_up(std::string_view interface_name);
         tl::expected<void, Error> create_vcan_interface(std::string_view interface_name);
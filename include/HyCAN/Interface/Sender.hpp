@@ -1,21 +1,51 @@
 #ifndef SENDER_HPP
 #define SENDER_HPP
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
 #include <cstring>
 #include <format>
+#include <span>
 #include <string_view>
 #include <unistd.h>
 
 #include "CanFrameConvertible.hpp"
+#include "Executor.hpp"
 #include "Socket.hpp"
 
 namespace HyCAN {
+template <AnyCanFrameConvertible T> class SendAwaiter;
+
+// How far a send_batch() got: the first `sent` frames went out, and
+// `status` says why the rest did not. CANSocketBufferFull means the
+// socket or device queue filled up; resend the remainder later.
+struct BatchSendResult {
+    size_t sent = 0;
+    tl::expected<void, Error> status{};
+
+    explicit operator bool() const noexcept { return status.has_value(); }
+};
+
+// Where send_blocking() found the socket full and waited for room.
+struct SendBlockStats {
+    uint64_t full = 0;     // calls that found the socket or device queue full
+    uint64_t spun = 0;     // of those, sent within the spin window
+    uint64_t timeouts = 0; // of those, gave up with CANSocketBufferFull
+    uint64_t blocked_total_ns = 0; // time spent waiting, summed over calls
+    uint64_t blocked_max_ns = 0;
+};
+
 class Sender {
   public:
+    using Clock = std::chrono::steady_clock;
+
     explicit Sender(std::string_view interface_name);
     Sender() = delete;
 
-    template <CanFrameConvertible T>
+    template <AnyCanFrameConvertible T>
     tl::expected<void, Error> send(T frame) noexcept {
 
         if (socket.get_sock_fd() <= 0) {
@@ -23,12 +53,24 @@ class Sender {
                 return res;
             }
         }
+        if constexpr (!CanFrameConvertible<T>) {
+            if (!socket.fd_frames_enabled()) {
+                return tl::make_unexpected(Error{
+                    ErrorCode::CANFdNotSupported,
+                    std::format("CAN FD frames are not supported on {}",
+                                socket.get_interface_name())});
+            }
+        }
         auto do_write = [&](int fd) -> ssize_t {
-            if constexpr (std::is_same_v<T, can_frame>) {
+            if constexpr (std::is_same_v<T, can_frame> ||
+                          std::is_same_v<T, canfd_frame>) {
                 return write(fd, &frame, sizeof(frame));
-            } else {
+            } else if constexpr (CanFrameConvertible<T>) {
                 const auto cf = static_cast<can_frame>(frame);
                 return write(fd, &cf, sizeof(cf));
+            } else {
+                const auto cfd = static_cast<canfd_frame>(frame);
+                return write(fd, &cfd, sizeof(cfd));
             }
         };
         ssize_t result = do_write(socket.get_sock_fd());
@@ -65,10 +107,229 @@ class Sender {
                               strerror(current_err), current_err)});
     }
 
+    // Sends the frames in order with one sendmmsg per up to
+    // MAX_BATCH_FRAMES frames, stopping at the first frame the kernel
+    // does not take.
+    template <AnyCanFrameConvertible T>
+    BatchSendResult send_batch(const std::span<const T> frames) noexcept {
+        if (socket.get_sock_fd() <= 0) {
+            if (auto res = socket.ensure_connected(); !res) {
+                return {0, tl::unexpected(res.error())};
+            }
+        }
+        if constexpr (!CanFrameConvertible<T>) {
+            if (!socket.fd_frames_enabled()) {
+                return {0, tl::make_unexpected(Error{
+                               ErrorCode::CANFdNotSupported,
+                               std::format(
+                                   "CAN FD frames are not supported on {}",
+                                   socket.get_interface_name())})};
+            }
+        }
+        if constexpr (std::is_same_v<T, can_frame> ||
+                      std::is_same_v<T, canfd_frame>) {
+            return send_frames(frames.data(), frames.size(), sizeof(T));
+        } else {
+            // Converted a chunk at a time, without allocating.
+            using Wire = std::conditional_t<CanFrameConvertible<T>,
+                                            can_frame, canfd_frame>;
+            std::array<Wire, MAX_BATCH_FRAMES> wire;
+            BatchSendResult result;
+            while (result.sent < frames.size()) {
+                const size_t count =
+                    std::min(frames.size() - result.sent, wire.size());
+                for (size_t i = 0; i < count; ++i) {
+                    wire[i] = static_cast<Wire>(frames[result.sent + i]);
+                }
+                const auto chunk =
+                    send_frames(wire.data(), count, sizeof(Wire));
+                result.sent += chunk.sent;
+                if (!chunk) {
+                    result.status = chunk.status;
+                    break;
+                }
+            }
+            return result;
+        }
+    }
+
+    // Like send(), but while the socket or device queue is full the
+    // caller waits for room, up to `timeout`: it retries in a busy loop for
+    // the first `spin`, which covers a queue that drains within
+    // microseconds, then sleeps in poll() until the socket is writable.
+    // Yields CANSocketBufferFull only once `timeout` has passed.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error>
+    send_blocking(T frame, const std::chrono::nanoseconds timeout,
+                  const std::chrono::nanoseconds spin = DEFAULT_SPIN) noexcept {
+        auto result = send(frame);
+        if (!buffer_full(result)) {
+            return result;
+        }
+        const auto start = Clock::now();
+        const auto deadline = timeout == std::chrono::nanoseconds::max()
+                                  ? Clock::time_point::max()
+                                  : start + timeout;
+        bool writable = false;
+        while (wait_for_room(start, deadline, spin, writable)) {
+            result = send(frame);
+            if (!buffer_full(result)) {
+                break;
+            }
+        }
+        record_blocked(start, spin, result);
+        return result;
+    }
+
+    // Safe to call from any thread.
+    [[nodiscard]] SendBlockStats get_block_stats() const noexcept;
+
+    // Like send(), but while the socket is full the awaiting Task yields
+    // its Executor until there is room or `timeout` has passed, which
+    // yields CANSocketBufferFull.
+    template <AnyCanFrameConvertible T>
+    SendAwaiter<T> send_async(T frame, std::chrono::nanoseconds timeout);
+
+    // Send buffer in bytes, kept across reconnects; 0 keeps the kernel
+    // default.
+    tl::expected<void, Error> set_send_buffer(const int bytes) noexcept {
+        return socket.set_send_buffer(bytes);
+    }
+
+    [[nodiscard]] tl::expected<int, Error> get_send_buffer() const noexcept {
+        return socket.send_buffer_size();
+    }
+
+    // Frames per sendmmsg call.
+    static constexpr size_t MAX_BATCH_FRAMES = 64;
+    // Busy-retry window of send_blocking() before it sleeps in poll().
+    static constexpr std::chrono::microseconds DEFAULT_SPIN{20};
+
   private:
+    template <AnyCanFrameConvertible T> friend class SendAwaiter;
+
+    // A full device queue (ENOBUFS) leaves the socket writable, so a
+    // retry after a writable wakeup that still fails is paced instead.
+    static constexpr std::chrono::microseconds RETRY_INTERVAL{200};
+    // Longest single poll() in send_blocking().
+    static constexpr std::chrono::milliseconds POLL_SLICE{1};
+
+    static bool buffer_full(const tl::expected<void, Error> &result) noexcept {
+        return !result && result.error().code == ErrorCode::CANSocketBufferFull;
+    }
+
+    // Waits a little for room in the socket: one pause while within
+    // `spin` of `start`, otherwise until POLLOUT or the deadline.
+    // `writable` carries whether the last poll() saw room. False once
+    // `deadline` has passed.
+    bool wait_for_room(Clock::time_point start, Clock::time_point deadline,
+                       std::chrono::nanoseconds spin,
+                       bool &writable) const noexcept;
+    // `result` is that of the last attempt; only a success counts as
+    // spun.
+    void record_blocked(Clock::time_point start,
+                        std::chrono::nanoseconds spin,
+                        const tl::expected<void, Error> &result) noexcept;
+
+    // send_batch() over `count` kernel frames of `frame_size` bytes each.
+    BatchSendResult send_frames(const void *frames, size_t count,
+                                size_t frame_size) noexcept;
+
     Socket socket;
     std::string_view interface_name;
+    std::atomic<uint64_t> stat_full{0};
+    std::atomic<uint64_t> stat_spun{0};
+    std::atomic<uint64_t> stat_timeouts{0};
+    std::atomic<uint64_t> stat_blocked_total_ns{0};
+    std::atomic<uint64_t> stat_blocked_max_ns{0};
+};
+
+// See Sender::send_async.
+template <AnyCanFrameConvertible T> class SendAwaiter {
+  public:
+    SendAwaiter(Sender &sender, T frame,
+                const std::chrono::nanoseconds timeout)
+        : sender(sender), frame(std::move(frame)),
+          result(this->sender.send(this->frame)),
+          deadline(timeout == std::chrono::nanoseconds::max()
+                       ? Executor::Clock::time_point::max()
+                       : Executor::Clock::now() + timeout) {}
+    SendAwaiter(const SendAwaiter &) = delete;
+    SendAwaiter &operator=(const SendAwaiter &) = delete;
+    ~SendAwaiter() {
+        if (waiting) {
+            executor->cancel_writable(this);
+        }
+        if (backoff_timer) {
+            executor->cancel_timer(*backoff_timer);
+        }
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept { return !full(); }
+    bool await_suspend(const std::coroutine_handle<> handle) {
+        executor = Executor::current();
+        if (!executor) {
+            return false;
+        }
+        this->handle = handle;
+        return wait();
+    }
+    tl::expected<void, Error> await_resume() { return std::move(result); }
+
+  private:
+    [[nodiscard]] bool full() const noexcept {
+        return Sender::buffer_full(result);
+    }
+
+    // Arms the next wakeup; false if the caller should resume now.
+    bool wait() {
+        const auto now = Executor::Clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        if (backoff) {
+            backoff_timer = executor->add_timer(
+                std::min(deadline, now + Sender::RETRY_INTERVAL), &retry,
+                this);
+            return true;
+        }
+        auto res = executor->wait_writable(sender.socket.get_sock_fd(),
+                                           deadline, &retry, this);
+        if (!res) {
+            result = tl::unexpected(std::move(res.error()));
+            return false;
+        }
+        waiting = true;
+        return true;
+    }
+
+    static void retry(void *self, const bool writable) {
+        auto &awaiter = *static_cast<SendAwaiter *>(self);
+        awaiter.waiting = false;
+        awaiter.backoff_timer.reset();
+        awaiter.backoff = writable;
+        awaiter.result = awaiter.sender.send(awaiter.frame);
+        if (!awaiter.full() || !awaiter.wait()) {
+            awaiter.handle.resume();
+        }
+    }
+
+    Sender &sender;
+    T frame;
+    tl::expected<void, Error> result;
+    Executor::Clock::time_point deadline;
+    Executor *executor{nullptr};
+    std::coroutine_handle<> handle;
+    bool waiting{false};
+    bool backoff{false};
+    std::optional<Executor::TimerId> backoff_timer;
 };
+
+template <AnyCanFrameConvertible T>
+SendAwaiter<T> Sender::send_async(T frame,
+                                  const std::chrono::nanoseconds timeout) {
+    return SendAwaiter<T>(*this, std::move(frame), timeout);
+}
 } // namespace HyCAN
 
 #endif // SENDER_HPP
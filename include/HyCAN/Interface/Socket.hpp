@@ -1,20 +1,36 @@
 #ifndef HYCAN_SOCKET_HPP
 #define HYCAN_SOCKET_HPP
 
+#include <chrono>
+#include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 #include <HyCAN/Util/Error.hpp>
+#include <linux/can.h>
 #include <tl/expected.hpp>
 #include <unistd.h>
 
 namespace HyCAN {
+// When the kernel received a frame (SO_TIMESTAMPNS, CLOCK_REALTIME). Zero
+// when receive timestamps are off.
+using RxTimestamp =
+    std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>;
+
 class Socket {
   public:
     explicit Socket(std::string_view interface_name);
     Socket(const Socket &) = delete;
     Socket &operator=(const Socket &) = delete;
     Socket(Socket &&other) noexcept
-        : sock_fd(other.sock_fd), interface_name(other.interface_name) {
+        : sock_fd(other.sock_fd), fd_frames(other.fd_frames),
+          timestamps(other.timestamps),
+          overflow_reports(other.overflow_reports),
+          error_mask(other.error_mask),
+          receive_buffer(other.receive_buffer),
+          send_buffer(other.send_buffer), filters(std::move(other.filters)),
+          interface_name(other.interface_name) {
         other.sock_fd = -1;
     }
     Socket &operator=(Socket &&other) noexcept {
@@ -22,6 +38,13 @@ class Socket {
             if (sock_fd > 0)
                 close(sock_fd);
             sock_fd = other.sock_fd;
+            fd_frames = other.fd_frames;
+            timestamps = other.timestamps;
+            overflow_reports = other.overflow_reports;
+            error_mask = other.error_mask;
+            receive_buffer = other.receive_buffer;
+            send_buffer = other.send_buffer;
+            filters = std::move(other.filters);
             interface_name = other.interface_name;
             other.sock_fd = -1;
         }
@@ -31,15 +54,67 @@ class Socket {
     ~Socket();
     tl::expected<void, Error> ensure_connected() noexcept;
     [[nodiscard]] tl::expected<void, Error> flush() const noexcept;
+    // Install a CAN_RAW_FILTER list; it is kept and re-applied whenever the
+    // socket reconnects. An empty list receives no data frames at all.
+    tl::expected<void, Error>
+    set_filters(std::span<const can_filter> new_filters) noexcept;
+
+    // Ask the kernel to attach a receive timestamp to every frame. Like
+    // the filters, the setting survives reconnects.
+    tl::expected<void, Error> set_timestamps(bool enable) noexcept;
+
+    // Have the kernel attach its count of frames dropped on this socket
+    // (SO_RXQ_OVFL) to every frame received after the first drop. Survives
+    // reconnects; the count itself starts over with each new socket.
+    tl::expected<void, Error> set_overflow_reports(bool enable) noexcept;
+
+    // Error classes (CAN_ERR_* of linux/can/error.h) the kernel delivers
+    // as error frames (CAN_RAW_ERR_FILTER); kept across reconnects. The
+    // kernel default is none.
+    tl::expected<void, Error> set_error_mask(can_err_mask_t mask) noexcept;
+
+    // Socket buffer sizes in bytes, kept across reconnects; 0 leaves the
+    // kernel default. Without CAP_NET_ADMIN the kernel caps them at
+    // net.core.rmem_max / wmem_max.
+    tl::expected<void, Error> set_receive_buffer(int bytes) noexcept;
+    tl::expected<void, Error> set_send_buffer(int bytes) noexcept;
+    // The sizes in effect, as reported by the kernel, which counts its own
+    // bookkeeping and so returns about twice the requested size.
+    [[nodiscard]] tl::expected<int, Error> receive_buffer_size() const noexcept;
+    [[nodiscard]] tl::expected<int, Error> send_buffer_size() const noexcept;
+
+    // Switch reads to blocking mode. A blocked read returns EAGAIN after
+    // `timeout`, so the reader can notice a stop request.
+    [[nodiscard]] tl::expected<void, Error>
+    make_blocking(std::chrono::milliseconds timeout) const noexcept;
 
     [[nodiscard]] int get_sock_fd() const { return sock_fd; }
 
+    // Whether CAN_RAW_FD_FRAMES was accepted on the current socket.
+    [[nodiscard]] bool fd_frames_enabled() const { return fd_frames; }
+
     [[nodiscard]] std::string_view get_interface_name() const {
         return interface_name;
     }
 
   private:
+    tl::expected<void, Error> apply_filters() const noexcept;
+    tl::expected<void, Error> apply_timestamps() const noexcept;
+    tl::expected<void, Error> apply_overflow_reports() const noexcept;
+    tl::expected<void, Error> apply_error_mask() const noexcept;
+    // `force_option` bypasses the sysctl cap, `option` is the fallback.
+    tl::expected<void, Error> apply_buffer(int force_option, int option,
+                                           int bytes) const noexcept;
+    tl::expected<int, Error> buffer_size(int option) const noexcept;
+
     int sock_fd{};
+    bool fd_frames{false};
+    bool timestamps{false};
+    bool overflow_reports{false};
+    can_err_mask_t error_mask{0};
+    int receive_buffer{0};
+    int send_buffer{0};
+    std::optional<std::vector<can_filter>> filters;
     std::string_view interface_name;
 };
 } // namespace HyCAN
@@ -0,0 +1,108 @@
+#ifndef HYCAN_STATIC_DISPATCHER_HPP
+#define HYCAN_STATIC_DISPATCHER_HPP
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string_view>
+
+#include <linux/can.h>
+#include <tl/expected.hpp>
+
+#include "Dispatcher.hpp"
+
+namespace HyCAN {
+/**
+ * @brief A callback bound to one CAN ID at compile time.
+ *
+ * `Func` is a constant, such as a function pointer or a lambda without
+ * captures, so the call can be inlined. As with register_func, IDs above
+ * 0x7FF or carrying CAN_EFF_FLAG are extended IDs, and `T` is the frame
+ * type the callback takes.
+ */
+template <size_t Id, auto Func, typename T = can_frame>
+    requires(AnyCanFrameConvertible<T> && FrameHandler<decltype(Func), T>)
+struct Handler {
+    static_assert((Id & ~static_cast<size_t>(CAN_EFF_FLAG)) <= CAN_EFF_MASK,
+                  "CAN ID exceeds the 29-bit extended ID range");
+
+    // The ID as it appears in the can_id of a received data frame.
+    static constexpr canid_t key =
+        (Id & CAN_EFF_FLAG) || Id > CAN_SFF_MASK
+            ? static_cast<canid_t>(Id & CAN_EFF_MASK) | CAN_EFF_FLAG
+            : static_cast<canid_t>(Id);
+
+    static void call(const canfd_frame &frame, const RxTimestamp timestamp) {
+        static constexpr auto func = Func;
+        invoke_frame_handler<T>(func, frame, timestamp);
+    }
+};
+
+/**
+ * @brief A Dispatcher whose callbacks are fixed at compile time.
+ *
+ * Each frame is matched against the Handler IDs by a chain of constant
+ * comparisons that the compiler lowers to a switch, with every handler
+ * inlined into it: no table lookup and no indirect call per handler.
+ * The handlers run on the underlying Dispatcher's socket and reap thread,
+ * before its callback table; IDs they cover never reach the table, and
+ * are admitted by the kernel filter. Other IDs, remote and error frames
+ * can still be registered at runtime through dynamic().
+ *
+ * Static handlers are counted in get_id_stats(), but not in the latency
+ * or stage statistics.
+ */
+template <typename... Handlers> class StaticDispatcher {
+    static_assert(sizeof...(Handlers) > 0, "StaticDispatcher needs a Handler");
+
+  public:
+    // Table keys of the handled IDs, ascending.
+    static constexpr std::array<canid_t, sizeof...(Handlers)> keys = [] {
+        std::array<canid_t, sizeof...(Handlers)> sorted{Handlers::key...};
+        std::ranges::sort(sorted);
+        return sorted;
+    }();
+    static_assert(std::ranges::adjacent_find(keys) == keys.end(),
+                  "Each CAN ID may have only one static handler");
+
+    explicit StaticDispatcher(
+        const std::string_view interface_name,
+        const std::optional<uint8_t> &cpu_core_opt = std::nullopt,
+        const DispatcherOptions &options = {})
+        : dispatcher(interface_name, cpu_core_opt, options) {
+        dispatcher.static_route = &StaticDispatcher::dispatch;
+        dispatcher.static_keys = keys;
+    }
+    // Receive on `group`'s thread instead of a dedicated one.
+    StaticDispatcher(const std::string_view interface_name,
+                     DispatcherGroup &group,
+                     const DispatcherOptions &options = {})
+        : dispatcher(interface_name, group, options) {
+        dispatcher.static_route = &StaticDispatcher::dispatch;
+        dispatcher.static_keys = keys;
+    }
+
+    tl::expected<void, Error> start() noexcept { return dispatcher.start(); }
+    tl::expected<void, Error> stop() noexcept { return dispatcher.stop(); }
+
+    // The Dispatcher underneath, for runtime callbacks and statistics.
+    [[nodiscard]] Dispatcher &dynamic() noexcept { return dispatcher; }
+    [[nodiscard]] const Dispatcher &dynamic() const noexcept {
+        return dispatcher;
+    }
+
+    // Runs the handler of the frame's ID; false if there is none.
+    static bool dispatch(const canfd_frame &frame,
+                         const RxTimestamp timestamp) {
+        return ((frame.can_id == Handlers::key
+                     ? (Handlers::call(frame, timestamp), true)
+                     : false) ||
+                ...);
+    }
+
+  private:
+    Dispatcher dispatcher;
+};
+} // namespace HyCAN
+
+#endif // HYCAN_STATIC_DISPATCHER_HPP
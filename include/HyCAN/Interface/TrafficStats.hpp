@@ -0,0 +1,140 @@
+#ifndef HYCAN_TRAFFIC_STATS_HPP
+#define HYCAN_TRAFFIC_STATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <linux/can.h>
+
+#include "Socket.hpp"
+
+namespace HyCAN {
+// Traffic seen on one CAN ID.
+struct IdTrafficStats {
+    // Standard ID, or extended ID with CAN_EFF_FLAG set.
+    canid_t can_id = 0;
+    uint64_t frames = 0;
+    // Frames that arrived while the ID had no callback.
+    uint64_t dropped = 0;
+    RxTimestamp last_arrival{};
+    // Exponentially weighted (1/16) mean of the time between frames, and
+    // of each interval's deviation from that mean.
+    std::chrono::nanoseconds mean_interval{0};
+    std::chrono::nanoseconds jitter{0};
+};
+
+/**
+ * @brief Per-ID traffic counters written by the reap thread alone.
+ *
+ * A fixed, open-addressed table of one cache line per ID. The reap thread
+ * claims a slot the first time an ID shows up and afterwards only does
+ * relaxed loads and stores on that line; readers take snapshots with
+ * plain loads and never hold up the writer. A snapshot of one ID may mix
+ * fields from consecutive frames. An ID is looked up among a few slots
+ * from its hash; when those are taken by other IDs, which is certain once
+ * the table is full, its frames are only counted in untracked().
+ */
+class TrafficStats {
+  public:
+    // The capacity is rounded up to a power of two.
+    explicit TrafficStats(size_t capacity);
+
+    // Reap thread only. `key` is a DispatchTable key.
+    void record(const canid_t key, const RxTimestamp arrival,
+                const bool delivered) noexcept {
+        Slot *slot = find_or_claim(key);
+        if (!slot) [[unlikely]] {
+            bump(untracked_, 1);
+            return;
+        }
+        const int64_t now = arrival.time_since_epoch().count();
+        const int64_t last =
+            slot->last_arrival_ns.load(std::memory_order_relaxed);
+        bump(slot->frames, 1);
+        if (!delivered) {
+            bump(slot->dropped, 1);
+        }
+        slot->last_arrival_ns.store(now, std::memory_order_relaxed);
+        if (last == 0 || now < last) {
+            return;
+        }
+        const int64_t interval = now - last;
+        int64_t mean = slot->mean_interval_ns.load(std::memory_order_relaxed);
+        int64_t jitter = slot->jitter_ns.load(std::memory_order_relaxed);
+        if (mean == 0) {
+            mean = interval;
+        } else {
+            const int64_t deviation = interval - mean;
+            mean += deviation / EWMA_WEIGHT;
+            jitter += ((deviation < 0 ? -deviation : deviation) - jitter) /
+                      EWMA_WEIGHT;
+        }
+        slot->mean_interval_ns.store(mean, std::memory_order_relaxed);
+        slot->jitter_ns.store(jitter, std::memory_order_relaxed);
+    }
+
+    // Safe from any thread.
+    [[nodiscard]] std::vector<IdTrafficStats> snapshot() const;
+    [[nodiscard]] std::optional<IdTrafficStats> snapshot(canid_t key) const;
+    // Frames of IDs that found the table full.
+    [[nodiscard]] uint64_t untracked() const noexcept {
+        return untracked_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr canid_t EMPTY_SLOT = ~canid_t{0};
+    static constexpr int64_t EWMA_WEIGHT = 16;
+    // Slots looked at per frame. Bounds the cost of an untracked ID to a
+    // few cache lines, at the price of leaving some slots unclaimed.
+    static constexpr size_t MAX_PROBE = 8;
+
+    struct alignas(64) Slot {
+        std::atomic<canid_t> id{EMPTY_SLOT};
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<int64_t> last_arrival_ns{0};
+        std::atomic<int64_t> mean_interval_ns{0};
+        std::atomic<int64_t> jitter_ns{0};
+    };
+
+    static void bump(std::atomic<uint64_t> &counter,
+                     const uint64_t n) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + n,
+                      std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t probe_start(const canid_t key) const noexcept {
+        return (static_cast<uint32_t>(key) * 2654435769u) >> shift;
+    }
+
+    Slot *find_or_claim(const canid_t key) noexcept {
+        for (size_t i = 0, pos = probe_start(key); i <= mask && i < MAX_PROBE;
+             ++i, pos = (pos + 1) & mask) {
+            Slot &slot = slots[pos];
+            const canid_t id = slot.id.load(std::memory_order_relaxed);
+            if (id == key) [[likely]] {
+                return &slot;
+            }
+            if (id == EMPTY_SLOT) {
+                // Counters start at zero, so publishing the ID is enough.
+                slot.id.store(key, std::memory_order_release);
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] static IdTrafficStats read(const Slot &slot, canid_t id);
+
+    size_t mask;
+    unsigned shift;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> untracked_{0};
+};
+} // namespace HyCAN
+
+#endif // HYCAN_TRAFFIC_STATS_HPP
@@ -0,0 +1,118 @@
+#ifndef HYCAN_TX_QUEUE_HPP
+#define HYCAN_TX_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+#include <linux/can.h>
+#include <tl/expected.hpp>
+
+#include "CanFrameConvertible.hpp"
+#include "HyCAN/Util/MpscRing.hpp"
+#include "Sender.hpp"
+#include "WorkerPool.hpp"
+
+namespace HyCAN {
+struct TxQueueOptions {
+    // Frames waiting for the TX thread; rounded up to a power of two.
+    size_t capacity = 1024;
+    // Core and priority of the TX thread.
+    WorkerOptions thread;
+    // The idle TX thread spins briefly, then sleeps between looks at the
+    // queue: first `idle_poll`, doubling while the queue stays empty up to
+    // `max_idle_poll`. A frame thus waits at most about as long as the
+    // queue was empty before it, and never more than `max_idle_poll`; an
+    // idle queue costs 1/max_idle_poll wakeups a second. A zero
+    // idle_poll spins without sleeping.
+    std::chrono::microseconds idle_poll{50};
+    std::chrono::microseconds max_idle_poll{2000};
+};
+
+struct TxQueueStats {
+    uint64_t enqueued = 0;     // frames accepted by enqueue()
+    uint64_t rejected = 0;     // enqueue() calls that found the queue full
+    uint64_t sent = 0;         // frames the kernel took
+    uint64_t dropped = 0;      // frames refused with an error other than full
+    uint64_t full_retries = 0; // sends retried because the socket was full
+};
+
+/**
+ * @brief Transmit queue shared by any number of producer threads.
+ *
+ * enqueue() copies the frame into a lock-free MPSC ring and returns: no
+ * lock, no syscall, and no wait beyond losing a CAS to another producer.
+ * One TX thread owns the socket, pops what has accumulated and sends it
+ * with send_batch, in enqueue order. While the socket or device queue is
+ * full it holds the frames back and retries; only frames refused for
+ * other reasons are dropped. The thread polls, backing off while idle,
+ * instead of being woken, so producers never touch a futex either.
+ */
+class TxQueue {
+  public:
+    explicit TxQueue(std::string_view interface_name,
+                     const TxQueueOptions &options = {});
+    TxQueue(const TxQueue &) = delete;
+    TxQueue &operator=(const TxQueue &) = delete;
+    // Sends what is still queued, then joins the TX thread. Frames that
+    // then meet a full socket are dropped rather than waited for.
+    ~TxQueue();
+
+    // Any thread. Yields TxQueueFull, without queueing, if the ring is full.
+    template <AnyCanFrameConvertible T>
+    tl::expected<void, Error> enqueue(const T &frame) noexcept {
+        canfd_frame queued{};
+        if constexpr (CanFrameConvertible<T>) {
+            const auto classic = static_cast<can_frame>(frame);
+            std::memcpy(&queued, &classic, sizeof(classic));
+            queued.flags = 0;
+        } else {
+            queued = static_cast<canfd_frame>(frame);
+            queued.flags |= CANFD_FDF;
+        }
+        if (!ring.try_push(queued)) {
+            rejected.fetch_add(1, std::memory_order_relaxed);
+            return tl::make_unexpected(
+                Error{ErrorCode::TxQueueFull, "TX queue full"});
+        }
+        return {};
+    }
+
+    // Waits until every frame queued so far was sent or dropped, or until
+    // `timeout` has passed; returns whether they all were. Frames keep
+    // waiting for room while the bus does not acknowledge them, so an
+    // unbounded flush could hang.
+    bool flush(std::chrono::nanoseconds timeout) const;
+
+    [[nodiscard]] TxQueueStats stats() const noexcept;
+
+  private:
+    // Pause before resending into a full socket or device queue.
+    static constexpr std::chrono::microseconds RETRY_INTERVAL{200};
+    // Empty looks at the queue spent spinning, then yielding, before the
+    // idle TX thread starts to sleep.
+    static constexpr unsigned IDLE_SPINS = 64;
+    static constexpr unsigned IDLE_YIELDS = 16;
+
+    void run(const std::stop_token &stop_token);
+    // Sends batch[0, count) in order; returns once all of it was sent or
+    // dropped.
+    void send(const canfd_frame *batch, size_t count,
+              const std::stop_token &stop_token);
+
+    TxQueueOptions options;
+    Util::MpscRing<canfd_frame> ring;
+    Sender sender;
+    alignas(64) std::atomic<uint64_t> rejected{0};
+    // Written by the TX thread only.
+    alignas(64) std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> full_retries{0};
+    std::jthread thread;
+};
+} // namespace HyCAN
+
+#endif // HYCAN_TX_QUEUE_HPP
@@ -0,0 +1,139 @@
+#ifndef HYCAN_WATCHDOG_HPP
+#define HYCAN_WATCHDOG_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <linux/can.h>
+#include <tl/expected.hpp>
+
+#include "HyCAN/Util/Error.hpp"
+
+namespace HyCAN {
+// How fresh the IDs of a callback must stay; see Dispatcher::register_func.
+struct Freshness {
+    // Longest gap between two frames of one ID before it counts as stale.
+    std::chrono::nanoseconds deadline{};
+    // Runs on the reap thread with the stale ID (extended IDs carry
+    // CAN_EFF_FLAG). It fires once per silence: again only after frames
+    // resume and stop once more. A stale ID is looked at once per
+    // deadline, so the timeout after a single frame that ends a silence
+    // may come up to one deadline late. It may register and unregister
+    // callbacks, its own included.
+    std::function<void(size_t can_id)> on_timeout;
+};
+
+/**
+ * @brief Per-ID freshness deadlines on a single timerfd.
+ *
+ * Frames only stamp their ID's slot, with one relaxed store and no lock;
+ * the deadlines sit in one ordered map and the timerfd is armed for the
+ * earliest. When it fires, a watch whose ID has seen a frame since is
+ * moved to that frame's deadline, and one whose ID has not times out. A
+ * timed-out watch stays in the map one deadline ahead, which is where a
+ * resumed ID is noticed. Any number of watched IDs cost one fd and at
+ * most one timer expiry per deadline per ID.
+ *
+ * watch() and unwatch() may be called from any thread; the rest belongs
+ * to the reap thread. Timeout callbacks run with no lock held.
+ */
+class Watchdog {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // What a frame updates; lives as long as the watchdog, so table entries
+    // can point at it.
+    struct Slot {
+        std::atomic<Clock::rep> last_seen{0};
+    };
+
+    Watchdog();
+    Watchdog(const Watchdog &) = delete;
+    Watchdog &operator=(const Watchdog &) = delete;
+    ~Watchdog();
+
+    // Readable when a deadline has passed.
+    [[nodiscard]] int fd() const noexcept { return timer_fd; }
+
+    Slot &slot(canid_t key);
+    // `keys` are table keys. Their first deadline is `deadline` from now;
+    // frames received earlier do not count.
+    tl::expected<void, Error> watch(uint64_t handle_id,
+                                    std::span<const canid_t> keys,
+                                    const Freshness &freshness);
+    // Once these return, the removed watches' callbacks are not started
+    // again; one already running may still finish.
+    void unwatch(uint64_t handle_id);
+    void unwatch_key(canid_t key);
+
+    // A frame arrived on the slot's ID. expire() notices it, including
+    // the end of a silence.
+    static void touch(Slot &slot, const Clock::time_point now) noexcept {
+        slot.last_seen.store(now.time_since_epoch().count(),
+                             std::memory_order_relaxed);
+    }
+    // Whether expire() has work; for receive loops that poll instead of
+    // waiting on fd().
+    [[nodiscard]] bool due(const Clock::time_point now) const noexcept {
+        return now.time_since_epoch().count() >=
+               next_due.load(std::memory_order_relaxed);
+    }
+    // Times out the watches whose deadline has passed.
+    void expire(Clock::time_point now);
+
+  private:
+    struct Watch;
+    using Timers = std::multimap<Clock::time_point, Watch *>;
+    struct Watch {
+        uint64_t id;
+        uint64_t handle_id;
+        canid_t key;
+        Slot *slot;
+        std::chrono::nanoseconds deadline;
+        std::function<void(size_t)> on_timeout;
+        Timers::iterator timer;
+        // Set while timed out: the slot's last_seen when it did, so a
+        // later frame shows as a change.
+        std::optional<Clock::rep> stale_since;
+    };
+    // A timeout to report once mutex_ is released.
+    struct Timeout {
+        uint64_t watch_id;
+        canid_t key;
+        std::function<void(size_t)> on_timeout;
+    };
+
+    void remove_if(const std::function<bool(const Watch &)> &pred);
+    // Points the timerfd at the earliest deadline; callers hold mutex_.
+    tl::expected<void, Error> rearm();
+
+    int timer_fd{-1};
+    std::mutex mutex_;
+    std::unordered_map<canid_t, Slot> slots;
+    // By an id of their own, so expire() can tell whether one it is about
+    // to report was removed meanwhile.
+    std::unordered_map<uint64_t, Watch> watches;
+    uint64_t next_watch_id{0};
+    // Bumped by every removal; expire() only looks a watch up again when
+    // it moved.
+    std::atomic<uint64_t> removals{0};
+    Timers timers;
+    // Reap thread only; kept to reuse its capacity.
+    std::vector<Timeout> timed_out;
+    Clock::time_point armed{Clock::time_point::max()};
+    // The earliest deadline, for due().
+    std::atomic<Clock::rep> next_due{Clock::time_point::max()
+                                         .time_since_epoch()
+                                         .count()};
+};
+} // namespace HyCAN
+
+#endif // HYCAN_WATCHDOG_HPP
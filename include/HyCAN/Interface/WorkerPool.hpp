@@ -0,0 +1,110 @@
+#ifndef HYCAN_WORKER_POOL_HPP
+#define HYCAN_WORKER_POOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <linux/can.h>
+
+#include "HyCAN/Util/InlineFunction.hpp"
+#include "HyCAN/Util/SpscRing.hpp"
+#include "Socket.hpp"
+
+namespace HyCAN {
+using FrameCallback =
+    Util::InlineFunction<void(const canfd_frame &, RxTimestamp)>;
+
+struct WorkerOptions {
+    // Core the worker is pinned to; it may run anywhere when empty.
+    std::optional<uint8_t> cpu_core;
+    // SCHED_FIFO priority, or 0 to stay a normal SCHED_OTHER thread.
+    int priority = 0;
+};
+
+struct DeferredStats {
+    uint64_t queued = 0;    // frames handed to the worker
+    uint64_t executed = 0;  // callbacks the worker has finished
+    uint64_t overflows = 0; // frames dropped because the ring was full
+};
+
+/**
+ * @brief Threads that run deferred callbacks off the reap thread.
+ *
+ * Every worker owns an SPSC ring of (callback, frame) tasks. The reap
+ * thread is the only producer; pushing never blocks, and a frame that
+ * finds the ring full is dropped and counted. An idle worker sleeps on a
+ * futex that the producer only touches when the worker actually sleeps.
+ */
+class WorkerPool {
+  public:
+    // An empty `workers` list still starts one default worker.
+    WorkerPool(std::span<const WorkerOptions> workers, size_t queue_depth);
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+    // Runs what is still queued, then joins the workers.
+    ~WorkerPool();
+
+    // Producer side; each worker must only be fed by one thread.
+    void push(size_t worker, const FrameCallback *target,
+              const canfd_frame &frame, RxTimestamp timestamp) noexcept;
+    // Tasks pushed to each worker so far, for passed().
+    [[nodiscard]] std::vector<uint64_t> marks() const;
+    // Whether every worker has finished the tasks counted in `marks`.
+    // Never waits, so a callback running on a worker may call it too.
+    [[nodiscard]] bool passed(std::span<const uint64_t> marks) const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept { return workers.size(); }
+    [[nodiscard]] std::vector<DeferredStats> stats() const;
+
+  private:
+    struct Task {
+        const FrameCallback *target;
+        canfd_frame frame;
+        RxTimestamp timestamp;
+    };
+
+    struct Worker {
+        explicit Worker(const size_t queue_depth) : ring(queue_depth) {}
+
+        Util::SpscRing<Task> ring;
+        // Written by the producer only.
+        alignas(64) std::atomic<uint64_t> overflows{0};
+        // 1 while the worker waits for work.
+        alignas(64) std::atomic<uint32_t> sleeping{0};
+        // Written by the worker only, after each callback returns.
+        alignas(64) std::atomic<uint64_t> executed{0};
+        std::jthread thread;
+    };
+
+    static void run(Worker &worker, const WorkerOptions &options,
+                    const std::stop_token &stop_token);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+};
+
+// Table entry of a deferred callback: queues the frame for its worker
+// instead of running the callback on the reap thread.
+class DeferredCallback {
+  public:
+    DeferredCallback(WorkerPool &pool, const size_t worker,
+                     FrameCallback target)
+        : pool(&pool), worker(worker), target(std::move(target)) {}
+
+    void operator()(const canfd_frame &frame,
+                    const RxTimestamp timestamp) const {
+        pool->push(worker, &target, frame, timestamp);
+    }
+
+  private:
+    WorkerPool *pool;
+    size_t worker;
+    FrameCallback target;
+};
+} // namespace HyCAN
+
+#endif // HYCAN_WORKER_POOL_HPP
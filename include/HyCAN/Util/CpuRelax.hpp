@@ -0,0 +1,18 @@
+#ifndef HYCAN_CPU_RELAX_HPP
+#define HYCAN_CPU_RELAX_HPP
+
+namespace HyCAN::Util
+{
+    // Spin-wait hint: lets the sibling hyperthread run and saves power
+    // while a busy loop polls. Does nothing where there is no such hint.
+    inline void cpu_relax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+}
+
+#endif //HYCAN_CPU_RELAX_HPP
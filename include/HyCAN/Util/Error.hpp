@@ -28,6 +28,9 @@ enum class ErrorCode {
     CANSocketBufferFull,
     CANInvalidSocketError,
     CANFlushError,
+    CANFdNotSupported,
+    CANFilterError,
+    CANSocketOptionError,
 
     // Reaper
     EpollError,
@@ -37,6 +40,18 @@ enum class ErrorCode {
     CPUAffinityError,
     EmptyFuncError,
     FuncCANIdSetError,
+    WatchdogError,
+
+    // Coroutines
+    ReceiveTimeout,
+    ExecutorError,
+
+    // Transmit queue
+    TxQueueFull,
+    TxQueueNotEnabled,
+
+    // Broadcast manager
+    CANBcmError,
 };
 
 struct Error {
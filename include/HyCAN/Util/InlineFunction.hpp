@@ -0,0 +1,143 @@
+#ifndef HYCAN_INLINE_FUNCTION_HPP
+#define HYCAN_INLINE_FUNCTION_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace HyCAN::Util
+{
+    template <typename Signature, size_t Capacity = 48>
+    class InlineFunction;
+
+    /**
+     * @brief Copyable callable wrapper with in-place storage.
+     *
+     * Callables up to `Capacity` bytes are stored inside the object, so with
+     * the default capacity a whole InlineFunction fits one cache line and a
+     * call is a single indirect jump. Larger callables are boxed on the heap
+     * once, at construction; calling them never allocates.
+     */
+    template <typename R, typename... Args, size_t Capacity>
+    class InlineFunction<R(Args...), Capacity>
+    {
+    public:
+        InlineFunction() noexcept = default;
+
+        template <typename F>
+            requires(!std::same_as<std::decay_t<F>, InlineFunction> && std::copy_constructible<std::decay_t<F>> &&
+                     std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        InlineFunction(F&& f) // NOLINT(google-explicit-constructor)
+        {
+            using D = std::decay_t<F>;
+            if constexpr (fits_inline<D>)
+            {
+                ::new (static_cast<void*>(storage_)) D(std::forward<F>(f));
+                invoke_ = &invoke_inline<D>;
+                ops_ = &inline_ops<D>;
+            }
+            else
+            {
+                ::new (static_cast<void*>(storage_)) D*(new D(std::forward<F>(f)));
+                invoke_ = &invoke_boxed<D>;
+                ops_ = &boxed_ops<D>;
+            }
+        }
+
+        InlineFunction(const InlineFunction& other) : invoke_(other.invoke_), ops_(other.ops_)
+        {
+            if (ops_)
+            {
+                ops_->copy(other.storage_, storage_);
+            }
+        }
+
+        InlineFunction(InlineFunction&& other) noexcept { take(other); }
+
+        InlineFunction& operator=(InlineFunction other) noexcept
+        {
+            reset();
+            take(other);
+            return *this;
+        }
+
+        ~InlineFunction() { reset(); }
+
+        explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+        R operator()(Args... args) const { return invoke_(storage_, std::forward<Args>(args)...); }
+
+    private:
+        struct Ops
+        {
+            void (*copy)(const void* from, void* to);
+            void (*move)(void* from, void* to) noexcept;
+            void (*destroy)(void* target) noexcept;
+        };
+
+        template <typename D>
+        static constexpr bool fits_inline = sizeof(D) <= Capacity && alignof(D) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<D>;
+
+        template <typename D>
+        static R invoke_inline(void* storage, Args&&... args)
+        {
+            return (*std::launder(static_cast<D*>(storage)))(std::forward<Args>(args)...);
+        }
+
+        template <typename D>
+        static R invoke_boxed(void* storage, Args&&... args)
+        {
+            return (**std::launder(static_cast<D**>(storage)))(std::forward<Args>(args)...);
+        }
+
+        template <typename D>
+        static constexpr Ops inline_ops{
+            [](const void* from, void* to) { ::new (to) D(*std::launder(static_cast<const D*>(from))); },
+            [](void* from, void* to) noexcept
+            {
+                D* source = std::launder(static_cast<D*>(from));
+                ::new (to) D(std::move(*source));
+                source->~D();
+            },
+            [](void* target) noexcept { std::launder(static_cast<D*>(target))->~D(); },
+        };
+
+        template <typename D>
+        static constexpr Ops boxed_ops{
+            [](const void* from, void* to) { ::new (to) D*(new D(**std::launder(static_cast<D* const*>(from)))); },
+            [](void* from, void* to) noexcept { ::new (to) D*(*std::launder(static_cast<D**>(from))); },
+            [](void* target) noexcept { delete *std::launder(static_cast<D**>(target)); },
+        };
+
+        void take(InlineFunction& other) noexcept
+        {
+            if (other.ops_)
+            {
+                other.ops_->move(other.storage_, storage_);
+                invoke_ = std::exchange(other.invoke_, nullptr);
+                ops_ = std::exchange(other.ops_, nullptr);
+            }
+        }
+
+        void reset() noexcept
+        {
+            if (ops_)
+            {
+                ops_->destroy(storage_);
+                invoke_ = nullptr;
+                ops_ = nullptr;
+            }
+        }
+
+        // The call target comes first so it shares a cache line with
+        // whatever precedes the wrapper.
+        R (*invoke_)(void*, Args&&...) = nullptr;
+        const Ops* ops_ = nullptr;
+        alignas(std::max_align_t) mutable unsigned char storage_[Capacity];
+    };
+}
+
+#endif //HYCAN_INLINE_FUNCTION_HPP
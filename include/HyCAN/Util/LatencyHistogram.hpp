@@ -0,0 +1,160 @@
+#ifndef HYCAN_LATENCY_HISTOGRAM_HPP
+#define HYCAN_LATENCY_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace HyCAN::Util
+{
+    // Values below 2^SUB_BUCKET_BITS get a bucket each; above that, every
+    // power of two is split into 2^SUB_BUCKET_BITS linear steps, which
+    // bounds the relative error of a reported value to 1/16.
+    inline constexpr unsigned SUB_BUCKET_BITS = 4;
+    inline constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+    // Values from 2^MAX_VALUE_BITS ns (about 18 minutes) up share the last
+    // bucket.
+    inline constexpr unsigned MAX_VALUE_BITS = 40;
+    inline constexpr size_t LATENCY_BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    // Bucket holding `value`.
+    constexpr size_t latency_bucket(const uint64_t value) noexcept
+    {
+        if (value < SUB_BUCKETS)
+        {
+            return static_cast<size_t>(value);
+        }
+        const unsigned magnitude = std::bit_width(value) - 1;
+        if (magnitude >= MAX_VALUE_BITS)
+        {
+            return LATENCY_BUCKETS - 1;
+        }
+        const unsigned shift = magnitude - SUB_BUCKET_BITS;
+        return (magnitude - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    // Largest value that falls into `bucket`.
+    constexpr uint64_t latency_bucket_limit(const size_t bucket) noexcept
+    {
+        if (bucket < SUB_BUCKETS)
+        {
+            return bucket;
+        }
+        const size_t shift = bucket / SUB_BUCKETS - 1;
+        const uint64_t lowest = (SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+        return lowest + (uint64_t{1} << shift) - 1;
+    }
+
+    /**
+     * @brief Point-in-time copy of a LatencyHistogram, in nanoseconds.
+     */
+    struct LatencySnapshot
+    {
+        uint64_t count = 0;
+        uint64_t total_ns = 0;
+        uint64_t min_ns = 0;
+        uint64_t max_ns = 0;
+        std::array<uint64_t, LATENCY_BUCKETS> buckets{};
+
+        [[nodiscard]] double mean_ns() const noexcept
+        {
+            return count ? static_cast<double>(total_ns) / static_cast<double>(count) : 0.0;
+        }
+
+        // Smallest recorded value that at least `percent` percent of the
+        // samples do not exceed, to within the bucket resolution.
+        [[nodiscard]] uint64_t percentile(const double percent) const noexcept
+        {
+            if (count == 0)
+            {
+                return 0;
+            }
+            const double wanted = std::clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(count);
+            const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(wanted + 0.5));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < buckets.size(); ++i)
+            {
+                seen += buckets[i];
+                if (seen >= rank)
+                {
+                    return std::clamp(latency_bucket_limit(i), min_ns, max_ns);
+                }
+            }
+            return max_ns;
+        }
+    };
+
+    /**
+     * @brief Log-linear (HDR-style) latency histogram with a single writer.
+     *
+     * record() is a handful of relaxed loads and stores into fixed storage:
+     * no locks, no allocation, no read-modify-write instructions. Any
+     * thread may take a snapshot() at any time; it may be off by the few
+     * samples recorded while it was being taken.
+     */
+    class LatencyHistogram
+    {
+    public:
+        // Only one thread may record into a histogram.
+        void record(const uint64_t value_ns) noexcept
+        {
+            bump(buckets_[latency_bucket(value_ns)], 1);
+            bump(count_, 1);
+            bump(total_ns_, value_ns);
+            if (value_ns < min_ns_.load(std::memory_order_relaxed))
+            {
+                min_ns_.store(value_ns, std::memory_order_relaxed);
+            }
+            if (value_ns > max_ns_.load(std::memory_order_relaxed))
+            {
+                max_ns_.store(value_ns, std::memory_order_relaxed);
+            }
+        }
+
+        [[nodiscard]] LatencySnapshot snapshot() const noexcept
+        {
+            LatencySnapshot result;
+            result.count = count_.load(std::memory_order_relaxed);
+            result.total_ns = total_ns_.load(std::memory_order_relaxed);
+            const uint64_t min = min_ns_.load(std::memory_order_relaxed);
+            result.min_ns = min == std::numeric_limits<uint64_t>::max() ? 0 : min;
+            result.max_ns = max_ns_.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < LATENCY_BUCKETS; ++i)
+            {
+                result.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+            }
+            return result;
+        }
+
+        // Exact only while nothing is being recorded.
+        void reset() noexcept
+        {
+            for (auto& bucket : buckets_)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            count_.store(0, std::memory_order_relaxed);
+            total_ns_.store(0, std::memory_order_relaxed);
+            min_ns_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+            max_ns_.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static void bump(std::atomic<uint64_t>& counter, const uint64_t n) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        std::atomic<uint64_t> count_{0};
+        std::atomic<uint64_t> total_ns_{0};
+        std::atomic<uint64_t> min_ns_{std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> max_ns_{0};
+        std::array<std::atomic<uint64_t>, LATENCY_BUCKETS> buckets_{};
+    };
+}
+
+#endif //HYCAN_LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,105 @@
+#ifndef HYCAN_MPSC_RING_HPP
+#define HYCAN_MPSC_RING_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace HyCAN::Util
+{
+    /**
+     * @brief Bounded multi-producer, single-consumer ring.
+     *
+     * Each slot carries a sequence number telling producers whether it is
+     * free and the consumer whether it is filled, so neither side ever
+     * blocks: a producer claims a slot with one CAS, retried only when
+     * another producer won the same slot, and fails at once if the ring is
+     * full. A producer stalled between claiming and filling a slot holds
+     * back the consumer, but no other producer.
+     */
+    template <typename T>
+    class MpscRing
+    {
+    public:
+        // The capacity is rounded up to a power of two.
+        explicit MpscRing(const size_t capacity) :
+            mask_(std::bit_ceil(capacity < 2 ? size_t{2} : capacity) - 1), cells_(std::make_unique<Cell[]>(mask_ + 1))
+        {
+            for (size_t i = 0; i <= mask_; ++i)
+            {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscRing(const MpscRing&) = delete;
+        MpscRing& operator=(const MpscRing&) = delete;
+
+        // Any thread. Returns false, leaving the ring untouched, if full.
+        bool try_push(const T& value) noexcept
+        {
+            uint64_t head = head_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells_[head & mask_];
+                const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto lag = static_cast<int64_t>(sequence - head);
+                if (lag == 0)
+                {
+                    if (head_.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+                    {
+                        cell.value = value;
+                        cell.sequence.store(head + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (lag < 0)
+                {
+                    // The consumer has not freed the slot a lap ago.
+                    return false;
+                }
+                else
+                {
+                    head = head_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Consumer side. Returns false if the next slot is not filled yet.
+        bool try_pop(T& value) noexcept
+        {
+            const uint64_t tail = tail_.load(std::memory_order_relaxed);
+            Cell& cell = cells_[tail & mask_];
+            if (cell.sequence.load(std::memory_order_acquire) != tail + 1)
+            {
+                return false;
+            }
+            value = cell.value;
+            cell.sequence.store(tail + mask_ + 1, std::memory_order_release);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Slots claimed by producers and values popped so far; safe to read
+        // from any thread.
+        [[nodiscard]] uint64_t pushed() const noexcept { return head_.load(std::memory_order_acquire); }
+        [[nodiscard]] uint64_t popped() const noexcept { return tail_.load(std::memory_order_acquire); }
+
+        [[nodiscard]] size_t capacity() const noexcept { return mask_ + 1; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<uint64_t> sequence;
+            T value;
+        };
+
+        const size_t mask_;
+        std::unique_ptr<Cell[]> cells_;
+        alignas(64) std::atomic<uint64_t> head_{0};
+        alignas(64) std::atomic<uint64_t> tail_{0};
+    };
+}
+
+#endif //HYCAN_MPSC_RING_HPP
@@ -0,0 +1,113 @@
+#ifndef HYCAN_RCU_PTR_HPP
+#define HYCAN_RCU_PTR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace HyCAN::Util
+{
+    /**
+     * @brief Read-copy-update pointer for a small, fixed set of reader threads.
+     *
+     * Readers announce themselves in their own cache-line slot and then load
+     * the pointer; neither step takes a lock or loops. Writers (serialized by
+     * the caller) publish a new object with publish(), which never waits:
+     * it hands the old one back with its retire epoch, and the caller keeps
+     * it until released() says no reader can still see it.
+     */
+    template <typename T>
+    class RcuPtr
+    {
+    public:
+        static constexpr size_t MAX_READERS = 16;
+
+        class ReadGuard
+        {
+        public:
+            ReadGuard(RcuPtr& rcu, const size_t reader) noexcept : slot_(rcu.readers_[reader].epoch)
+            {
+                // seq_cst store followed by seq_cst load: either exchange()
+                // sees this slot, or we see the pointer it published.
+                slot_.store(rcu.epoch_.load(std::memory_order_acquire), std::memory_order_seq_cst);
+                ptr_ = rcu.ptr_.load(std::memory_order_seq_cst);
+            }
+
+            ~ReadGuard() { slot_.store(0, std::memory_order_release); }
+
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+            T* operator->() const noexcept { return ptr_; }
+            T& operator*() const noexcept { return *ptr_; }
+
+        private:
+            std::atomic<uint64_t>& slot_;
+            T* ptr_;
+        };
+
+        explicit RcuPtr(std::unique_ptr<T> initial) : ptr_(initial.release())
+        {
+        }
+
+        ~RcuPtr() { delete ptr_.load(std::memory_order_acquire); }
+
+        RcuPtr(const RcuPtr&) = delete;
+        RcuPtr& operator=(const RcuPtr&) = delete;
+
+        // Reader side; `reader` is a slot index owned by the calling thread.
+        ReadGuard read(const size_t reader) noexcept { return ReadGuard(*this, reader); }
+
+        // Writer side; only valid while the caller holds its writer lock.
+        [[nodiscard]] const T& current() const noexcept { return *ptr_.load(std::memory_order_acquire); }
+
+        // An object taken out by publish(), with the epoch readers must
+        // move past before it may be freed.
+        struct Retired
+        {
+            std::unique_ptr<T> object;
+            uint64_t epoch;
+        };
+
+        // Publish `next` and return the previous object without waiting for
+        // readers.
+        [[nodiscard]] Retired publish(std::unique_ptr<T> next)
+        {
+            T* old = ptr_.exchange(next.release(), std::memory_order_seq_cst);
+            const uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+            return {std::unique_ptr<T>(old), epoch};
+        }
+
+        // Whether every reader is quiescent or entered after `epoch`, so none
+        // can still reference an object retired at it. The seq_cst loads
+        // pair with the store in ReadGuard: a reader missed here loads the
+        // new pointer.
+        [[nodiscard]] bool released(const uint64_t epoch) const noexcept
+        {
+            for (const auto& reader : readers_)
+            {
+                const uint64_t seen = reader.epoch.load(std::memory_order_seq_cst);
+                if (seen != 0 && seen <= epoch)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        struct alignas(64) ReaderSlot
+        {
+            // 0 while quiescent, otherwise the epoch seen on entry.
+            std::atomic<uint64_t> epoch{0};
+        };
+
+        std::atomic<T*> ptr_;
+        std::atomic<uint64_t> epoch_{1};
+        std::array<ReaderSlot, MAX_READERS> readers_{};
+    };
+}
+
+#endif //HYCAN_RCU_PTR_HPP
@@ -0,0 +1,89 @@
+#ifndef HYCAN_SEQ_LOCK_HPP
+#define HYCAN_SEQ_LOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "CpuRelax.hpp"
+
+namespace HyCAN::Util
+{
+    /**
+     * @brief Single-writer sequence lock around a trivially copyable value.
+     *
+     * The writer never waits. Readers copy the value out and retry if a
+     * write overlapped the copy; they never store to shared memory, so any
+     * number of them can poll without slowing the writer. The value is
+     * kept in relaxed atomic words, which makes the torn copies a retry
+     * discards well-defined.
+     */
+    template <typename T>
+    class SeqLock
+    {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>);
+
+    public:
+        // Writer side, one thread only.
+        void store(const T& value) noexcept
+        {
+            const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+            sequence_.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::array<uint64_t, WORDS> buffer{};
+            std::memcpy(buffer.data(), &value, sizeof(T));
+            for (size_t i = 0; i < WORDS; ++i)
+            {
+                words_[i].store(buffer[i], std::memory_order_relaxed);
+            }
+            sequence_.store(sequence + 2, std::memory_order_release);
+        }
+
+        // Any thread. `stores` receives how many stores the value reflects;
+        // 0 means it is still default-constructed.
+        T load(uint64_t& stores) const noexcept
+        {
+            std::array<uint64_t, WORDS> buffer;
+            for (;;)
+            {
+                const uint64_t before = sequence_.load(std::memory_order_acquire);
+                if (before & 1)
+                {
+                    cpu_relax();
+                    continue;
+                }
+                for (size_t i = 0; i < WORDS; ++i)
+                {
+                    buffer[i] = words_[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == before)
+                {
+                    stores = before / 2;
+                    break;
+                }
+            }
+            T value;
+            // Through void*: T need only be trivially copyable.
+            std::memcpy(static_cast<void*>(&value), buffer.data(), sizeof(T));
+            return value;
+        }
+
+        // Completed stores, without copying the value.
+        [[nodiscard]] uint64_t stores() const noexcept
+        {
+            return sequence_.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        // Odd while a store is in progress.
+        std::atomic<uint64_t> sequence_{0};
+        std::array<std::atomic<uint64_t>, WORDS> words_{};
+    };
+}
+
+#endif //HYCAN_SEQ_LOCK_HPP
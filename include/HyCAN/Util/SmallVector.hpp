@@ -0,0 +1,172 @@
+#ifndef HYCAN_SMALL_VECTOR_HPP
+#define HYCAN_SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace HyCAN::Util
+{
+    /**
+     * @brief Contiguous vector that keeps up to `N` elements in place.
+     *
+     * While it holds at most `N` elements they live inside the object, so
+     * reaching them needs no pointer load; growing past `N` moves everything
+     * to one heap array, and shrinking back moves them home again. Either
+     * way iteration is over contiguous storage.
+     */
+    template <typename T, size_t N>
+    class SmallVector
+    {
+    public:
+        SmallVector() noexcept = default;
+
+        SmallVector(const SmallVector& other)
+        {
+            T* target = inline_data();
+            if (other.size_ > N)
+            {
+                heap_ = target = std::allocator<T>{}.allocate(other.size_);
+                capacity_ = other.size_;
+            }
+            try
+            {
+                std::uninitialized_copy(other.begin(), other.end(), target);
+            }
+            catch (...)
+            {
+                free_heap();
+                throw;
+            }
+            size_ = other.size_;
+        }
+
+        SmallVector(SmallVector&& other) noexcept { take(other); }
+
+        SmallVector& operator=(const SmallVector& other)
+        {
+            if (this != &other)
+            {
+                SmallVector copy(other);
+                reset();
+                take(copy);
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                take(other);
+            }
+            return *this;
+        }
+
+        ~SmallVector() { reset(); }
+
+        [[nodiscard]] T* begin() noexcept { return size_ <= N ? inline_data() : heap_; }
+        [[nodiscard]] const T* begin() const noexcept { return size_ <= N ? inline_data() : heap_; }
+        [[nodiscard]] T* end() noexcept { return begin() + size_; }
+        [[nodiscard]] const T* end() const noexcept { return begin() + size_; }
+        [[nodiscard]] size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (size_ < N)
+            {
+                T* slot = ::new (static_cast<void*>(inline_data() + size_)) T(std::forward<Args>(args)...);
+                ++size_;
+                return *slot;
+            }
+            if (size_ == N || size_ == capacity_)
+            {
+                // Build the new element first so a throwing constructor
+                // leaves the vector untouched.
+                const uint32_t capacity = size_ == N ? static_cast<uint32_t>(N * 2) : capacity_ * 2;
+                T* grown = std::allocator<T>{}.allocate(capacity);
+                ::new (static_cast<void*>(grown + size_)) T(std::forward<Args>(args)...);
+                std::uninitialized_move(begin(), end(), grown);
+                std::destroy(begin(), end());
+                free_heap();
+                heap_ = grown;
+                capacity_ = capacity;
+                return heap_[size_++];
+            }
+            T* slot = ::new (static_cast<void*>(heap_ + size_)) T(std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        }
+
+        // Removes matching elements, keeping the others in order.
+        template <typename Pred>
+        size_t erase_if(Pred&& pred)
+        {
+            T* first = begin();
+            T* kept = std::remove_if(first, end(), pred);
+            const auto remaining = static_cast<uint32_t>(kept - first);
+            const uint32_t removed = size_ - remaining;
+            std::destroy(kept, end());
+            if (size_ > N && remaining <= N)
+            {
+                std::uninitialized_move(heap_, heap_ + remaining, inline_data());
+                std::destroy(heap_, heap_ + remaining);
+                free_heap();
+            }
+            size_ = remaining;
+            return removed;
+        }
+
+    private:
+        [[nodiscard]] T* inline_data() noexcept { return std::launder(reinterpret_cast<T*>(inline_)); }
+        [[nodiscard]] const T* inline_data() const noexcept
+        {
+            return std::launder(reinterpret_cast<const T*>(inline_));
+        }
+
+        void free_heap() noexcept
+        {
+            if (heap_)
+            {
+                std::allocator<T>{}.deallocate(heap_, capacity_);
+                heap_ = nullptr;
+                capacity_ = 0;
+            }
+        }
+
+        void reset() noexcept
+        {
+            std::destroy(begin(), end());
+            size_ = 0;
+            free_heap();
+        }
+
+        // Steals other's heap block, or moves its inline elements.
+        void take(SmallVector& other) noexcept
+        {
+            if (other.size_ <= N)
+            {
+                std::uninitialized_move(other.begin(), other.end(), inline_data());
+                size_ = other.size_;
+                other.reset();
+                return;
+            }
+            heap_ = std::exchange(other.heap_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+
+        uint32_t size_ = 0;
+        uint32_t capacity_ = 0; // of heap_, when allocated
+        T* heap_ = nullptr;
+        alignas(T) unsigned char inline_[N * sizeof(T)];
+    };
+}
+
+#endif //HYCAN_SMALL_VECTOR_HPP
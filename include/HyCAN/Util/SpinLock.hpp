@@ -3,6 +3,8 @@
 
 #include <atomic>
 
+#include "CpuRelax.hpp"
+
 namespace HyCAN::Util
 {
     class SpinLock
@@ -18,9 +20,8 @@ namespace HyCAN::Util
                 }
                 while (lock_.load(std::memory_order_relaxed))
                 {
-                    __builtin_ia32_pause();
-                    // Currently don't support Arm machine. Need someone help.
-                    // std::this_thread::yield(); performance is bad.
+                    // Not std::this_thread::yield(): its performance is bad.
+                    cpu_relax();
                 }
             }
         }
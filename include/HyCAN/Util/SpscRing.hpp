@@ -0,0 +1,88 @@
+#ifndef HYCAN_SPSC_RING_HPP
+#define HYCAN_SPSC_RING_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace HyCAN::Util
+{
+    /**
+     * @brief Bounded single-producer, single-consumer ring.
+     *
+     * Both ends are wait-free: a push or pop is a couple of loads and one
+     * release store. Each side caches the other's index and only reloads it
+     * when the ring looks full (or empty), so in steady state the two cores
+     * share no written cache line except the slots themselves.
+     */
+    template <typename T>
+    class SpscRing
+    {
+    public:
+        // The capacity is rounded up to a power of two.
+        explicit SpscRing(const size_t capacity) :
+            mask_(std::bit_ceil(capacity < 2 ? size_t{2} : capacity) - 1), slots_(std::make_unique<T[]>(mask_ + 1))
+        {
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        // Producer side. Returns false, leaving the ring untouched, if full.
+        bool try_push(const T& value) noexcept
+        {
+            const uint64_t head = producer_.index.load(std::memory_order_relaxed);
+            if (head - producer_.cached > mask_)
+            {
+                producer_.cached = consumer_.index.load(std::memory_order_acquire);
+                if (head - producer_.cached > mask_)
+                {
+                    return false;
+                }
+            }
+            slots_[head & mask_] = value;
+            producer_.index.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side. Returns false if the ring is empty.
+        bool try_pop(T& value) noexcept
+        {
+            const uint64_t tail = consumer_.index.load(std::memory_order_relaxed);
+            if (tail == consumer_.cached)
+            {
+                consumer_.cached = producer_.index.load(std::memory_order_acquire);
+                if (tail == consumer_.cached)
+                {
+                    return false;
+                }
+            }
+            value = slots_[tail & mask_];
+            consumer_.index.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Number of pushes and pops so far; safe to read from any thread.
+        [[nodiscard]] uint64_t pushed() const noexcept { return producer_.index.load(std::memory_order_acquire); }
+        [[nodiscard]] uint64_t popped() const noexcept { return consumer_.index.load(std::memory_order_acquire); }
+
+        [[nodiscard]] size_t capacity() const noexcept { return mask_ + 1; }
+
+    private:
+        struct alignas(64) End
+        {
+            std::atomic<uint64_t> index{0};
+            // The other end's index as last seen by this end.
+            uint64_t cached = 0;
+        };
+
+        const size_t mask_;
+        std::unique_ptr<T[]> slots_;
+        End producer_;
+        End consumer_;
+    };
+}
+
+#endif //HYCAN_SPSC_RING_HPP
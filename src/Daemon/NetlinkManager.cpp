@@ -163,7 +163,8 @@ namespace HyCAN
         return NetlinkResponse(0, "Success");
     }
 
-    NetlinkResponse NetlinkManager::set_can_bitrate_libnl(std::string_view interface_name, const uint32_t bitrate) const
+    NetlinkResponse NetlinkManager::set_can_bitrate_libnl(std::string_view interface_name, const uint32_t bitrate,
+                                                          const uint32_t data_bitrate) const
     {
         std::lock_guard lock(mutex_);
         if (!interface_name.starts_with("can"))
@@ -196,6 +197,14 @@ namespace HyCAN
             }
 
             rtnl_link_can_set_bitrate(change, bitrate);
+            if (data_bitrate != 0)
+            {
+                // CAN FD: 开启 FD 模式并设置数据段比特率, 采样点由内核计算
+                can_bittiming data_bittiming{};
+                data_bittiming.bitrate = data_bitrate;
+                rtnl_link_can_set_data_bittiming(change, &data_bittiming);
+                rtnl_link_can_set_ctrlmode(change, CAN_CTRLMODE_FD);
+            }
             const int result = rtnl_link_change(nl_socket_, link, change, 0);
 
             rtnl_link_put(change);
@@ -265,7 +274,8 @@ namespace HyCAN
                     }
 
                     // 设置比特率
-                    const auto bitrate_result = set_can_bitrate_libnl(request.interface_name, request.bitrate);
+                    const auto bitrate_result = set_can_bitrate_libnl(request.interface_name, request.bitrate,
+                                                                      request.fd_mode ? request.data_bitrate : 0);
                     if (bitrate_result.result != 0)
                     {
                         // 如果设置比特率失败，返回错误，此时接口已经是 "down" 状态
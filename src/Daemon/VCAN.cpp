@@ -3,6 +3,7 @@
 #include <cstring>
 #include <cerrno>
 
+#include <linux/can.h>
 #include <net/if.h>
 #include <netlink/netlink.h>
 #include <netlink/route/link.h>
@@ -49,6 +50,8 @@ namespace HyCAN
 
         rtnl_link_set_name(link, std::string(interface_name).c_str());
         rtnl_link_set_type(link, "vcan");
+        // CAN FD sized MTU, so the interface carries both classic and FD frames
+        rtnl_link_set_mtu(link, CANFD_MTU);
 
         const int result = rtnl_link_add(sock, link, NLM_F_CREATE);
 
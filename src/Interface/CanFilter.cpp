@@ -0,0 +1,122 @@
+#include "HyCAN/Interface/CanFilter.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace HyCAN {
+namespace {
+// An aligned block of 2^free_bits IDs starting at `base`.
+struct Block {
+    bool extended;
+    canid_t base;
+    uint8_t free_bits;
+
+    [[nodiscard]] uint64_t size() const { return uint64_t{1} << free_bits; }
+};
+
+uint8_t id_bits(const bool extended) { return extended ? 29 : 11; }
+
+// Smallest aligned block containing both a and b (same kind).
+Block merge(const Block &a, const Block &b) {
+    const canid_t diff = a.base ^ b.base;
+    const auto diff_bits =
+        static_cast<uint8_t>(diff == 0 ? 0 : std::bit_width(diff));
+    const uint8_t free_bits =
+        std::max({a.free_bits, b.free_bits, diff_bits});
+    const canid_t low_mask = (canid_t{1} << free_bits) - 1;
+    return {a.extended, a.base & ~low_mask, free_bits};
+}
+
+bool contains(const Block &outer, const Block &inner) {
+    if (outer.extended != inner.extended ||
+        inner.free_bits > outer.free_bits) {
+        return false;
+    }
+    const canid_t low_mask = (canid_t{1} << outer.free_bits) - 1;
+    return (inner.base & ~low_mask) == outer.base;
+}
+
+can_filter to_filter(const Block &block) {
+    const canid_t id_mask =
+        ((canid_t{1} << id_bits(block.extended)) - 1) &
+        ~((canid_t{1} << block.free_bits) - 1);
+    if (block.extended) {
+        return {.can_id = block.base | CAN_EFF_FLAG,
+                .can_mask = id_mask | CAN_EFF_FLAG};
+    }
+    return {.can_id = block.base, .can_mask = id_mask | CAN_EFF_FLAG};
+}
+} // namespace
+
+std::vector<can_filter> build_can_filters(const std::span<const canid_t> keys,
+                                          size_t max_filters) {
+    max_filters = std::max<size_t>(max_filters, 2);
+    std::vector<Block> blocks;
+    blocks.reserve(keys.size());
+    for (const canid_t key : keys) {
+        const bool extended = key & CAN_EFF_FLAG;
+        blocks.push_back({extended,
+                          key & (extended ? CAN_EFF_MASK : CAN_SFF_MASK), 0});
+    }
+    std::ranges::sort(blocks, [](const Block &a, const Block &b) {
+        return a.extended != b.extended ? !a.extended : a.base < b.base;
+    });
+    blocks.erase(std::unique(blocks.begin(), blocks.end(),
+                             [](const Block &a, const Block &b) {
+                                 return a.extended == b.extended &&
+                                        a.base == b.base;
+                             }),
+                 blocks.end());
+
+    while (blocks.size() > max_filters) {
+        // Pick the neighbouring pair whose merge admits the fewest new IDs.
+        size_t best = blocks.size();
+        uint64_t best_cost = std::numeric_limits<uint64_t>::max();
+        for (size_t i = 0; i + 1 < blocks.size(); ++i) {
+            if (blocks[i].extended != blocks[i + 1].extended) {
+                continue;
+            }
+            const Block merged = merge(blocks[i], blocks[i + 1]);
+            uint64_t covered = 0;
+            for (size_t j = i; j < blocks.size() && contains(merged, blocks[j]);
+                 ++j) {
+                covered += blocks[j].size();
+            }
+            for (size_t j = i; j-- > 0 && contains(merged, blocks[j]);) {
+                covered += blocks[j].size();
+            }
+            if (const uint64_t cost = merged.size() - covered;
+                cost < best_cost) {
+                best_cost = cost;
+                best = i;
+            }
+        }
+        if (best == blocks.size()) {
+            break; // one standard and one extended block left
+        }
+        const Block merged = merge(blocks[best], blocks[best + 1]);
+        // Blocks are sorted and aligned, so the ones swallowed by the merge
+        // form a contiguous run around `best`.
+        size_t first = best;
+        while (first > 0 && contains(merged, blocks[first - 1])) {
+            --first;
+        }
+        size_t last = best + 1;
+        while (last < blocks.size() && contains(merged, blocks[last])) {
+            ++last;
+        }
+        blocks[first] = merged;
+        blocks.erase(blocks.begin() + static_cast<std::ptrdiff_t>(first) + 1,
+                     blocks.begin() + static_cast<std::ptrdiff_t>(last));
+    }
+
+    std::vector<can_filter> filters;
+    filters.reserve(blocks.size());
+    for (const auto &block : blocks) {
+        filters.push_back(to_filter(block));
+    }
+    return filters;
+}
+} // namespace HyCAN
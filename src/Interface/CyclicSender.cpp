@@ -0,0 +1,178 @@
+#include "HyCAN/Interface/CyclicSender.hpp"
+
+#include <fcntl.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <format>
+
+using tl::unexpected, std::format;
+using enum HyCAN::ErrorCode;
+
+namespace HyCAN {
+namespace {
+// A bcm_msg_head with room for one frame of either kind behind it.
+constexpr size_t MESSAGE_SIZE = sizeof(bcm_msg_head) + sizeof(canfd_frame);
+
+bcm_timeval to_timeval(const std::chrono::microseconds interval) {
+    const auto seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(interval);
+    return {.tv_sec = seconds.count(),
+            .tv_usec = (interval - seconds).count()};
+}
+} // namespace
+
+CyclicSender::CyclicSender(const std::string_view interface_name)
+    : interface_name(interface_name) {}
+
+CyclicSender::~CyclicSender() {
+    if (sock_fd >= 0) {
+        close(sock_fd);
+    }
+}
+
+tl::expected<void, Error> CyclicSender::ensure_connected() noexcept {
+    if (sock_fd >= 0) {
+        return {};
+    }
+    const int fd = socket(PF_CAN, SOCK_DGRAM, CAN_BCM);
+    if (fd == -1) {
+        return unexpected(
+            Error{CANSocketCreateError,
+                  format("Failed to create CAN BCM socket: {}",
+                         strerror(errno))});
+    }
+    ifreq ifr{};
+    const auto name_len =
+        std::min(interface_name.size(), static_cast<size_t>(IFNAMSIZ - 1));
+    std::memcpy(ifr.ifr_name, interface_name.data(), name_len);
+    ifr.ifr_name[name_len] = '\0';
+    if (ioctl(fd, SIOCGIFINDEX, &ifr) == -1) {
+        const int err = errno;
+        close(fd);
+        return unexpected(
+            Error{CANInterfaceIndexError,
+                  format("Failed to get CAN interface '{}' index: {}",
+                         ifr.ifr_name, strerror(err))});
+    }
+    // A BCM socket is connected rather than bound to its interface.
+    sockaddr_can addr{};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (connect(fd, reinterpret_cast<const sockaddr *>(&addr),
+                sizeof(addr)) == -1) {
+        const int err = errno;
+        close(fd);
+        return unexpected(
+            Error{CANSocketBindError,
+                  format("Failed to connect CAN BCM socket: {}",
+                         strerror(err))});
+    }
+    const int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    sock_fd = fd;
+    return {};
+}
+
+tl::expected<void, Error>
+CyclicSender::setup(const uint32_t opcode, const uint32_t flags,
+                    const canfd_frame &frame, const bool fd,
+                    const std::chrono::microseconds ival1,
+                    const std::chrono::microseconds ival2) noexcept {
+    if (auto res = ensure_connected(); !res) {
+        return res;
+    }
+    bcm_msg_head head{};
+    head.opcode = opcode;
+    head.flags = flags | (fd ? CAN_FD_FRAME : 0);
+    head.ival1 = to_timeval(ival1);
+    head.ival2 = to_timeval(ival2);
+    head.can_id = frame.can_id;
+    head.nframes = 1;
+    const size_t size =
+        sizeof(head) + (fd ? sizeof(canfd_frame) : sizeof(can_frame));
+    alignas(bcm_msg_head) std::array<char, MESSAGE_SIZE> message;
+    std::memcpy(message.data(), &head, sizeof(head));
+    std::memcpy(message.data() + sizeof(head), &frame, size - sizeof(head));
+    if (write(sock_fd, message.data(), size) != static_cast<ssize_t>(size)) {
+        return unexpected(Error{
+            CANBcmError, format("BCM request {} for CAN ID {:#x} failed: {}",
+                                opcode, head.can_id, strerror(errno))});
+    }
+    return {};
+}
+
+tl::expected<void, Error> CyclicSender::remove(const uint32_t opcode,
+                                               std::map<canid_t, bool> &tasks,
+                                               const canid_t can_id) noexcept {
+    const auto it = tasks.find(can_id);
+    if (it == tasks.end()) {
+        return unexpected(Error{
+            CANBcmError,
+            format("CAN ID {:#x} is not set up with the BCM", can_id)});
+    }
+    bcm_msg_head head{};
+    head.opcode = opcode;
+    head.flags = it->second ? CAN_FD_FRAME : 0;
+    head.can_id = can_id;
+    if (write(sock_fd, &head, sizeof(head)) != sizeof(head)) {
+        return unexpected(Error{
+            CANBcmError, format("BCM request {} for CAN ID {:#x} failed: {}",
+                                opcode, can_id, strerror(errno))});
+    }
+    tasks.erase(it);
+    return {};
+}
+
+tl::expected<void, Error> CyclicSender::stop(const canid_t can_id) {
+    return remove(TX_DELETE, cyclic, can_id);
+}
+
+tl::expected<void, Error> CyclicSender::unwatch(const canid_t can_id) {
+    return remove(RX_DELETE, watched, can_id);
+}
+
+tl::expected<std::optional<CyclicEvent>, Error>
+CyclicSender::read_event() noexcept {
+    if (sock_fd < 0) {
+        return std::nullopt;
+    }
+    alignas(bcm_msg_head) std::array<char, MESSAGE_SIZE> message;
+    while (true) {
+        const ssize_t nbytes = read(sock_fd, message.data(), message.size());
+        if (nbytes == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return std::nullopt;
+            }
+            return unexpected(
+                Error{CANBcmError, format("Failed to read from BCM socket: {}",
+                                          strerror(errno))});
+        }
+        if (static_cast<size_t>(nbytes) < sizeof(bcm_msg_head)) {
+            continue;
+        }
+        bcm_msg_head head;
+        std::memcpy(&head, message.data(), sizeof(head));
+        CyclicEvent event{CyclicEvent::Kind::Timeout, head.can_id, {}};
+        if (head.opcode == RX_TIMEOUT) {
+            return event;
+        }
+        const size_t frame_size = (head.flags & CAN_FD_FRAME)
+                                      ? sizeof(canfd_frame)
+                                      : sizeof(can_frame);
+        // Status replies and the like are not asked for; skip them.
+        if (head.opcode != RX_CHANGED || head.nframes < 1 ||
+            static_cast<size_t>(nbytes) < sizeof(head) + frame_size) {
+            continue;
+        }
+        event.kind = CyclicEvent::Kind::Changed;
+        std::memcpy(&event.frame, message.data() + sizeof(head), frame_size);
+        return event;
+    }
+}
+} // namespace HyCAN
@@ -1,4 +1,7 @@
 #include "HyCAN/Interface/Dispatcher.hpp"
+#include "HyCAN/Interface/CanFilter.hpp"
+#include "HyCAN/Interface/Mailbox.hpp"
+#include "HyCAN/Util/CpuRelax.hpp"
 
 #include <linux/can.h>
 #include <sys/epoll.h>
@@ -6,6 +9,8 @@
 #include <sys/mman.h>
 #include <sys/sysinfo.h>
 
+#include <algorithm>
+#include <bit>
 #include <chrono>
 #include <cstring>
 #include <utility>
@@ -52,10 +57,38 @@ inline tl::expected<void, Error> affinize_cpu(const uint8_t cpu) {
 
 inline bool has_root_privileges() noexcept { return geteuid() == 0; }
 
+// The SO_TIMESTAMPNS control message of a received frame, if any.
+// Returns the frame's receive timestamp, if it has one, and updates
+// `drops` from its SO_RXQ_OVFL count, if it has one.
+inline HyCAN::RxTimestamp read_control(msghdr &header,
+                                       uint32_t &drops) noexcept {
+    HyCAN::RxTimestamp timestamp{};
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg;
+         cmsg = CMSG_NXTHDR(&header, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+        if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec ts;
+            std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            timestamp =
+                HyCAN::RxTimestamp(std::chrono::seconds(ts.tv_sec) +
+                                   std::chrono::nanoseconds(ts.tv_nsec));
+        } else if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+            std::memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+        }
+    }
+    return timestamp;
+}
+
 namespace HyCAN {
 Dispatcher::Dispatcher(const std::string_view interface_name,
-                       const std::optional<uint8_t>& cpu_core_opt)
-    : socket(interface_name), interface_name(interface_name) {
+                       const std::optional<uint8_t> &cpu_core_opt,
+                       const DispatcherOptions &options)
+    : socket(interface_name), options(options),
+      interface_name(interface_name) {
+    init_rx_buffers();
+
     epoll_fd = epoll_create(256);
     if (epoll_fd == -1) {
         throw std::runtime_error(format(
@@ -67,11 +100,60 @@ Dispatcher::Dispatcher(const std::string_view interface_name,
             format("Failed to create thread_event_fd file descriptor: {}",
                    strerror(errno)));
     }
-    (void)epoll_fd_add_sock_fd(thread_event_fd).map_error([](const auto &e) {
-        throw std::runtime_error(e.message);
-    });
+    (void)epoll_fd_add_sock_fd(thread_event_fd)
+        .and_then([&] { return epoll_fd_add_sock_fd(watchdog.fd()); })
+        .map_error([](const auto &e) { throw std::runtime_error(e.message); });
+
+    cpu_core =
+        cpu_core_opt.has_value() ? cpu_core_opt.value() : next_cpu_core();
+}
 
-    cpu_core = cpu_core_opt.has_value() ? cpu_core_opt.value() : thread_counter.fetch_add(1, std::memory_order_acquire) % get_nprocs();
+Dispatcher::Dispatcher(const std::string_view interface_name,
+                       DispatcherGroup &group, const DispatcherOptions &options)
+    : socket(interface_name), options(options), group(&group),
+      interface_name(interface_name) {
+    this->options.receive_mode = ReceiveMode::Epoll;
+    this->options.edge_triggered = false;
+    init_rx_buffers();
+}
+
+void Dispatcher::init_rx_buffers() {
+    if (options.batch_size == 0) {
+        options.batch_size = 1;
+    }
+    if (options.wakeup_budget == 0) {
+        options.wakeup_budget = options.batch_size;
+    }
+    rx_frames.resize(options.batch_size);
+    rx_iovecs.resize(options.batch_size);
+    rx_msgs.resize(options.batch_size);
+    for (size_t i = 0; i < options.batch_size; ++i) {
+        rx_iovecs[i] = {.iov_base = &rx_frames[i],
+                        .iov_len = sizeof(canfd_frame)};
+        rx_msgs[i] = {};
+        rx_msgs[i].msg_hdr.msg_iov = &rx_iovecs[i];
+        rx_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    // Always needed for drop counts; latency recording may also turn
+    // timestamps on later.
+    rx_control.resize(options.batch_size);
+    for (size_t i = 0; i < options.batch_size; ++i) {
+        rx_msgs[i].msg_hdr.msg_control = &rx_control[i];
+    }
+    (void)socket.set_overflow_reports(true);
+    (void)socket.set_error_mask(options.error_mask);
+    if (options.receive_buffer > 0) {
+        (void)socket.set_receive_buffer(options.receive_buffer);
+    }
+    if (options.id_stats_capacity > 0) {
+        traffic = std::make_unique<TrafficStats>(options.id_stats_capacity);
+    }
+    // Per-ID intervals need each frame's own arrival time; the read time
+    // is shared by a whole batch.
+    if (options.rx_timestamps || traffic) {
+        (void)socket.set_timestamps(true);
+    }
+    rx_stamping.store(options.rx_timestamps, std::memory_order_relaxed);
 }
 
 Dispatcher::~Dispatcher() {
@@ -85,18 +167,55 @@ Dispatcher::~Dispatcher() {
 }
 
 tl::expected<void, Error> Dispatcher::start() noexcept {
+    if (group) {
+        // Leave the group before the socket is replaced under its thread.
+        if (auto res = group->detach(*this); !res) {
+            return res;
+        }
+    }
+    {
+        std::lock_guard guard(table_mutex_);
+        if (auto res = sync_kernel_filter(); !res) {
+            return res;
+        }
+    }
+    // A new socket counts its drops from zero.
+    socket_drops_seen = 0;
+    receive_buffer_bytes = 0;
+    autosize_since = {};
+    if (group) {
+        return socket.ensure_connected()
+            .and_then([&] { return socket.flush(); })
+            .and_then([&] { return group->attach(*this); });
+    }
     return socket.ensure_connected()
-        .and_then([&] { return epoll_fd_add_sock_fd(socket.get_sock_fd()); })
+        .and_then([&] {
+            return epoll_fd_add_sock_fd(
+                socket.get_sock_fd(),
+                options.edge_triggered ? EPOLLIN | EPOLLET : EPOLLIN);
+        })
         .and_then([&] { return socket.flush(); })
+        .and_then([&]() -> tl::expected<void, Error> {
+            if (options.receive_mode == ReceiveMode::Blocking) {
+                return socket.make_blocking(BLOCKING_STOP_CHECK);
+            }
+            return {};
+        })
         .and_then([&] {
             if (!reap_thread.joinable()) {
-                reap_thread = jthread(&Dispatcher::reap_process, this);
+                reap_thread =
+                    jthread([this](const std::stop_token &stop_token) {
+                        reap_process(stop_token);
+                    });
             }
             return tl::expected<void, Error>{};
         });
 }
 
 tl::expected<void, Error> Dispatcher::stop() noexcept {
+    if (group) {
+        return group->detach(*this);
+    }
     if (reap_thread.joinable()) {
         reap_thread.request_stop();
         constexpr uint64_t one = 1;
@@ -112,15 +231,40 @@ tl::expected<void, Error> Dispatcher::stop() noexcept {
     return {};
 }
 
-void Dispatcher::reap_process(const std::stop_token &stop_token) {
+void Dispatcher::prepare_reap_thread(const uint8_t cpu_core) {
     (void)make_real_time();
     (void)affinize_cpu(cpu_core);
     if (has_root_privileges()) {
         (void)lock_memory();
     }
+}
+
+uint8_t Dispatcher::next_cpu_core() {
+    return thread_counter.fetch_add(1, std::memory_order_acquire) %
+           get_nprocs();
+}
+
+void Dispatcher::reap_process(const std::stop_token &stop_token) {
+    prepare_reap_thread(cpu_core);
+    switch (options.receive_mode) {
+    case ReceiveMode::Blocking:
+        return blocking_loop(stop_token);
+    case ReceiveMode::Spin:
+        return spin_loop(stop_token);
+    case ReceiveMode::Epoll:
+    case ReceiveMode::Hybrid:
+        return epoll_loop(stop_token);
+    }
+}
+
+void Dispatcher::epoll_loop(const std::stop_token &stop_token) {
     epoll_event events[MAX_EPOLL_EVENT]{};
+    // Set when an edge-triggered socket still holds frames after its budget
+    // ran out; epoll will not report it again until new data arrives.
+    bool rx_pending = false;
     while (true) {
-        const int nfds = epoll_wait(epoll_fd, events, MAX_EPOLL_EVENT, -1);
+        const int nfds =
+            epoll_wait(epoll_fd, events, MAX_EPOLL_EVENT, rx_pending ? 0 : -1);
         if (nfds == -1) {
             if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
                 if (stop_token.stop_requested())
@@ -135,56 +279,514 @@ void Dispatcher::reap_process(const std::stop_token &stop_token) {
             return;
         }
 
-        if (nfds == 0)
-            continue;
-
         for (int i = 0; i < nfds; ++i) {
-            if (events[i].data.fd == thread_event_fd &&
-                stop_token.stop_requested())
-                return;
+            if (events[i].data.fd == thread_event_fd) {
+                if (stop_token.stop_requested())
+                    return;
+                uint64_t value;
+                (void)read(thread_event_fd, &value, sizeof(value));
+                continue;
+            }
+            if (events[i].data.fd == watchdog.fd()) {
+                watchdog.expire(std::chrono::steady_clock::now());
+                continue;
+            }
             if (events[i].events & EPOLLIN) {
-                can_frame frame{};
-                if (const int fd = events[i].data.fd;
-                    read(fd, &frame, sizeof frame) > 0) {
-#ifdef HYCAN_LATENCY_TEST
-                    auto receive_time =
-                        std::chrono::high_resolution_clock::now();
-                    if (frame.len == 8) {
-                        uint64_t send_timestamp_ns_count;
-                        memcpy(&send_timestamp_ns_count, frame.data,
-                               sizeof(send_timestamp_ns_count));
-                        auto send_time_epoch_ns =
-                            std::chrono::nanoseconds(send_timestamp_ns_count);
-                        auto latency_duration_ns = std::chrono::duration_cast<
-                            std::chrono::nanoseconds>(
-                            receive_time.time_since_epoch() -
-                            send_time_epoch_ns);
-                        if (latency_duration_ns.count() >= 0) {
-                            accumulated_latency_ns.fetch_add(
-                                latency_duration_ns.count(),
-                                std::memory_order_relaxed);
-                            latency_message_count.fetch_add(
-                                1, std::memory_order_relaxed);
-                        }
-                    }
+                rx_pending = true;
+            }
+        }
 
-#endif
+        if (rx_pending) {
+            const auto result = drain(socket.get_sock_fd());
+            rx_pending = options.edge_triggered && !result.empty;
+            if (result.frames > 0 &&
+                options.receive_mode == ReceiveMode::Hybrid) {
+                spin_window(stop_token);
+                rx_pending = false;
+            }
+        }
+    }
+}
 
-                    lock_.lock();
-                    if (funcs[frame.can_id]) {
-                        funcs[frame.can_id](frame);
-                    }
-                    lock_.unlock();
-                }
+void Dispatcher::blocking_loop(const std::stop_token &stop_token) {
+    const int fd = socket.get_sock_fd();
+    while (!stop_token.stop_requested()) {
+        // Blocks for the first frame, then takes whatever else is queued.
+        if (const auto result = drain(fd, MSG_WAITFORONE, false);
+            result.frames == 0 && result.error != EAGAIN &&
+            result.error != EWOULDBLOCK && result.error != EINTR) {
+            // The interface went away; do not spin on the error.
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // The receive timeout bounds how late a deadline is noticed.
+        if (const auto now = std::chrono::steady_clock::now();
+            watchdog.due(now)) {
+            watchdog.expire(now);
+        }
+    }
+}
+
+void Dispatcher::spin_loop(const std::stop_token &stop_token) {
+    const int fd = socket.get_sock_fd();
+    while (!stop_token.stop_requested()) {
+        if (drain(fd, MSG_DONTWAIT, false).frames == 0) {
+            if (const auto now = std::chrono::steady_clock::now();
+                watchdog.due(now)) {
+                watchdog.expire(now);
+            }
+            Util::cpu_relax();
+        }
+    }
+}
+
+void Dispatcher::spin_window(const std::stop_token &stop_token) {
+    using Clock = std::chrono::steady_clock;
+    const int fd = socket.get_sock_fd();
+    auto deadline = Clock::now() + options.spin_window;
+    while (!stop_token.stop_requested()) {
+        const auto now = Clock::now();
+        if (now >= deadline) {
+            return;
+        }
+        // The timerfd is not looked at until the window closes.
+        if (watchdog.due(now)) {
+            watchdog.expire(now);
+        }
+        if (drain(fd, MSG_DONTWAIT, false).frames > 0) {
+            deadline = now + options.spin_window;
+        } else {
+            Util::cpu_relax();
+        }
+    }
+}
+
+Dispatcher::DrainResult Dispatcher::drain(const int fd, int flags,
+                                          const bool record_empty) {
+    const size_t budget = options.wakeup_budget;
+    size_t drained = 0;
+    bool empty = false;
+    const bool stamping = rx_stamping.load(std::memory_order_relaxed);
+    int error = 0;
+    uint32_t socket_drops = socket_drops_seen;
+    while (drained < budget) {
+        const auto want = static_cast<unsigned>(
+            std::min(rx_msgs.size(), budget - drained));
+        // The kernel shrinks msg_controllen to what it wrote.
+        for (unsigned i = 0; i < want; ++i) {
+            rx_msgs[i].msg_hdr.msg_controllen = sizeof(RxControl);
+        }
+        const int received = recvmmsg(fd, rx_msgs.data(), want, flags, nullptr);
+        flags = MSG_DONTWAIT;
+        ++drain_receive_calls;
+        if (stamping || traffic) {
+            rx_read_at = std::chrono::system_clock::now();
+        }
+        if (received <= 0) {
+            // EAGAIN, or the interface went away; either way nothing is left.
+            error = received == -1 ? errno : 0;
+            empty = true;
+            break;
+        }
+        // Taken per batch, never across a blocking recvmmsg: while it is
+        // alive, the table it loaded cannot be reclaimed.
+        const auto table = funcs.read(REAP_READER);
+        for (int i = 0; i < received; ++i) {
+            // Without timestamps, control data only shows up once the
+            // socket has dropped frames.
+            RxTimestamp arrival{};
+            if (rx_msgs[i].msg_hdr.msg_controllen > 0) {
+                arrival = read_control(rx_msgs[i].msg_hdr, socket_drops);
             }
+            rx_arrival = arrival;
+            const RxTimestamp timestamp = stamping ? arrival : RxTimestamp{};
+            canfd_frame &frame = rx_frames[i];
+            // Tag frames by the MTU the kernel delivered; older kernels do
+            // not set CANFD_FDF themselves, and for classic frames the byte
+            // is padding.
+            if (rx_msgs[i].msg_len == CANFD_MTU) {
+                frame.flags |= CANFD_FDF;
+            } else if (rx_msgs[i].msg_len == CAN_MTU) {
+                frame.flags = 0;
+            } else {
+                continue;
+            }
+            dispatch(*table, frame, timestamp);
+        }
+        drained += static_cast<size_t>(received);
+        if (static_cast<unsigned>(received) < want) {
+            // A short read means the receive queue was emptied.
+            empty = true;
+            break;
+        }
+    }
+    // The count is cumulative and wraps like the kernel's.
+    const uint32_t dropped = socket_drops - socket_drops_seen;
+    if (dropped > 0) [[unlikely]] {
+        socket_drops_seen = socket_drops;
+        stat_kernel_drops.store(
+            stat_kernel_drops.load(std::memory_order_relaxed) + dropped,
+            std::memory_order_relaxed);
+    }
+    if (drained > 0 || record_empty) {
+        record_drain(drained, !empty);
+    } else {
+        drain_receive_calls = 0;
+    }
+    if (options.auto_receive_buffer) {
+        autosize_receive_buffer(dropped > 0);
+    }
+    try_reclaim();
+    return {drained, empty, error};
+}
+
+void Dispatcher::record_drain(const size_t frames, const bool budget_hit) {
+    // Only the reap thread writes these, so plain load/store is enough.
+    const auto bump = [](std::atomic<uint64_t> &counter, const uint64_t n) {
+        counter.store(counter.load(std::memory_order_relaxed) + n,
+                      std::memory_order_relaxed);
+    };
+    bump(stat_wakeups, 1);
+    bump(stat_receive_calls, drain_receive_calls);
+    bump(stat_frames, frames);
+    if (budget_hit) {
+        bump(stat_budget_exhausted, 1);
+    }
+    if (frames > stat_max_wakeup_frames.load(std::memory_order_relaxed)) {
+        stat_max_wakeup_frames.store(frames, std::memory_order_relaxed);
+    }
+    const size_t bucket = std::min<size_t>(std::bit_width(frames),
+                                           DRAIN_HISTOGRAM_BUCKETS - 1);
+    bump(stat_drain_histogram[bucket], 1);
+    drain_receive_calls = 0;
+}
+
+void Dispatcher::autosize_receive_buffer(const bool dropped) {
+    const uint64_t frames = stat_frames.load(std::memory_order_relaxed);
+    if (!dropped && frames - autosize_frames < AUTOSIZE_SAMPLE_FRAMES) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (receive_buffer_bytes == 0) {
+        // The kernel reports twice what was asked for.
+        const auto current = socket.receive_buffer_size();
+        receive_buffer_bytes = current ? *current / 2 : 0;
+    }
+    uint64_t wanted = 0;
+    if (autosize_since != std::chrono::steady_clock::time_point{} &&
+        now > autosize_since) {
+        const auto elapsed = std::chrono::duration_cast<
+            std::chrono::nanoseconds>(now - autosize_since);
+        const auto headroom =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                options.receive_buffer_headroom);
+        // Frames expected within the headroom at the sampled rate.
+        const uint64_t backlog = (frames - autosize_frames) *
+                                 static_cast<uint64_t>(headroom.count()) /
+                                 static_cast<uint64_t>(elapsed.count());
+        wanted = backlog * QUEUED_FRAME_BYTES / 2;
+    }
+    if (dropped) {
+        wanted = std::max<uint64_t>(
+            wanted, 2 * static_cast<uint64_t>(receive_buffer_bytes));
+    }
+    wanted = std::min<uint64_t>(
+        wanted, static_cast<uint64_t>(options.max_receive_buffer));
+    if (wanted > static_cast<uint64_t>(receive_buffer_bytes)) {
+        if (socket.set_receive_buffer(static_cast<int>(wanted))) {
+            receive_buffer_bytes = static_cast<int>(wanted);
+        }
+    }
+    autosize_frames = frames;
+    autosize_since = now;
+}
+
+void Dispatcher::record_traffic(const canfd_frame &frame,
+                                const RxTimestamp timestamp,
+                                const bool delivered) {
+    if (!traffic) {
+        return;
+    }
+    const canid_t key = frame.can_id & CAN_EFF_FLAG
+                            ? frame.can_id & (CAN_EFF_MASK | CAN_EFF_FLAG)
+                            : frame.can_id & CAN_SFF_MASK;
+    RxTimestamp arrival = timestamp != RxTimestamp{} ? timestamp : rx_arrival;
+    if (arrival == RxTimestamp{}) [[unlikely]] {
+        arrival = rx_read_at;
+    }
+    traffic->record(key, arrival, delivered);
+}
+
+void Dispatcher::dispatch(CallbackTable &table, const canfd_frame &frame,
+                          const RxTimestamp timestamp) {
+    if (frame.can_id & (CAN_ERR_FLAG | CAN_RTR_FLAG)) [[unlikely]] {
+        dispatch_side(frame, timestamp);
+        return;
+    }
+    if (waiting.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+        wake_waiters(frame);
+    }
+    if (static_route && static_route(frame, timestamp)) {
+        record_traffic(frame, timestamp, true);
+        return;
+    }
+    auto *subscribers = table.find(frame.can_id);
+    record_traffic(frame, timestamp, subscribers != nullptr);
+    if (subscribers) {
+        if (subscribers->fresh) [[unlikely]] {
+            watchdog.touch(*subscribers->fresh,
+                           std::chrono::steady_clock::now());
+        }
+        // Frames only carry a timestamp while timing is wanted.
+        if (timestamp != RxTimestamp{}) [[unlikely]] {
+            const RxTimestamp started = std::chrono::system_clock::now();
+            for (const auto &subscriber : *subscribers) {
+                subscriber.callback(frame, timestamp);
+            }
+            record_timing(*subscribers, timestamp, started,
+                          std::chrono::system_clock::now());
+            return;
+        }
+        // A lone subscriber is stored inline, so this skips the loop and
+        // the heap pointer entirely.
+        if (subscribers->size() == 1) [[likely]] {
+            subscribers->begin()->callback(frame, timestamp);
+            return;
+        }
+        for (const auto &subscriber : *subscribers) {
+            subscriber.callback(frame, timestamp);
+        }
+    }
+}
+
+void Dispatcher::wake_waiters(const canfd_frame &frame) {
+    std::lock_guard guard(waiter_lock);
+    std::erase_if(waiters, [&](FrameWait *wait) {
+        if (wait->key != frame.can_id ||
+            (!wait->fd_frames && (frame.flags & CANFD_FDF))) {
+            return false;
+        }
+        wait->frame = frame;
+        // Not suspended yet: await_suspend sees Delivered and goes on.
+        if (wait->state.exchange(FrameWait::State::Delivered,
+                                 std::memory_order_acq_rel) ==
+            FrameWait::State::Suspended) {
+            wait->executor->post(wait->handle);
+        }
+        return true;
+    });
+    waiting.store(waiters.size(), std::memory_order_relaxed);
+}
+
+tl::expected<void, Error> Dispatcher::add_waiter(FrameWait &wait,
+                                                 const size_t can_id) {
+    const auto key = to_table_key(can_id);
+    if (!key) {
+        return tl::unexpected(Error{
+            ErrorCode::FuncCANIdSetError,
+            format("CAN ID {:#x} exceeds the 29-bit extended ID range",
+                   can_id)});
+    }
+    wait.key = *key;
+    if (auto res = admit_awaited(*key); !res) {
+        return res;
+    }
+    wait.admitted = true;
+    std::lock_guard guard(waiter_lock);
+    waiters.push_back(&wait);
+    waiting.store(waiters.size(), std::memory_order_relaxed);
+    return {};
+}
+
+tl::expected<void, Error> Dispatcher::admit_awaited(const canid_t key) {
+    {
+        std::lock_guard guard(awaited_mutex_);
+        if (const auto it = awaited_keys.find(key); it != awaited_keys.end()) {
+            ++it->second;
+            return {};
+        }
+    }
+    // The first await of the key widens the filter before it returns, so
+    // the reply cannot be dropped.
+    std::lock_guard table_guard(table_mutex_);
+    {
+        std::lock_guard guard(awaited_mutex_);
+        if (++awaited_keys[key] > 1) {
+            return {};
+        }
+    }
+    auto res = sync_kernel_filter();
+    if (!res) {
+        std::lock_guard guard(awaited_mutex_);
+        if (--awaited_keys[key] == 0) {
+            awaited_keys.erase(key);
+        }
+    }
+    return res;
+}
+
+void Dispatcher::release_awaited(const canid_t key) {
+    {
+        std::lock_guard guard(awaited_mutex_);
+        const auto it = awaited_keys.find(key);
+        if (it == awaited_keys.end() || --it->second > 0) {
+            return;
+        }
+        awaited_keys.erase(it);
+    }
+    // Narrowing can wait: if a writer holds the lock, its own update or
+    // the next one drops the key.
+    if (std::unique_lock lock(table_mutex_, std::try_to_lock); lock) {
+        (void)sync_kernel_filter();
+    }
+}
+
+bool Dispatcher::remove_waiter(FrameWait &wait) {
+    std::lock_guard guard(waiter_lock);
+    const bool removed = std::erase(waiters, &wait) > 0;
+    waiting.store(waiters.size(), std::memory_order_relaxed);
+    return removed;
+}
+
+FrameWait::FrameWait(Dispatcher &dispatcher, const size_t can_id,
+                     const std::chrono::nanoseconds timeout,
+                     const bool fd_frames)
+    : dispatcher(&dispatcher), fd_frames(fd_frames),
+      deadline(timeout == std::chrono::nanoseconds::max()
+                   ? Executor::Clock::time_point::max()
+                   : Executor::Clock::now() + timeout) {
+    if (auto res = dispatcher.add_waiter(*this, can_id); !res) {
+        error = std::move(res.error());
+        state.store(State::Failed, std::memory_order_relaxed);
+    }
+}
+
+FrameWait::~FrameWait() {
+    if (timer) {
+        executor->cancel_timer(*timer);
+    }
+    (void)dispatcher->remove_waiter(*this);
+    if (admitted) {
+        dispatcher->release_awaited(key);
+    }
+}
+
+bool FrameWait::await_ready() const noexcept {
+    const State current = state.load(std::memory_order_acquire);
+    return current == State::Delivered || current == State::Failed;
+}
+
+bool FrameWait::await_suspend(const std::coroutine_handle<> handle) {
+    executor = Executor::current();
+    if (!executor) {
+        if (dispatcher->remove_waiter(*this)) {
+            error = Error{ErrorCode::ExecutorError,
+                          "receive() awaited outside of an Executor"};
+            state.store(State::Failed, std::memory_order_relaxed);
+        }
+        return false;
+    }
+    this->handle = handle;
+    if (deadline != Executor::Clock::time_point::max()) {
+        timer = executor->add_timer(deadline, &FrameWait::expire, this);
+    }
+    State expected = State::Pending;
+    if (state.compare_exchange_strong(expected, State::Suspended,
+                                      std::memory_order_acq_rel)) {
+        return true;
+    }
+    // The frame arrived in the meantime.
+    if (timer) {
+        executor->cancel_timer(*timer);
+        timer.reset();
+    }
+    return false;
+}
+
+void FrameWait::expire(void *self, bool) {
+    auto &wait = *static_cast<FrameWait *>(self);
+    wait.timer.reset();
+    // Otherwise the frame won and its resume is already queued.
+    if (wait.dispatcher->remove_waiter(wait)) {
+        wait.state.store(State::TimedOut, std::memory_order_relaxed);
+        wait.handle.resume();
+    }
+}
+
+tl::expected<canfd_frame, Error> FrameWait::take() {
+    if (timer) {
+        executor->cancel_timer(*timer);
+        timer.reset();
+    }
+    switch (state.load(std::memory_order_acquire)) {
+    case State::Delivered:
+        return frame;
+    case State::TimedOut:
+        return tl::unexpected(Error{
+            ErrorCode::ReceiveTimeout,
+            format("No frame with CAN ID {:#x} before the timeout",
+                   key & CAN_EFF_MASK)});
+    default:
+        return tl::unexpected(*error);
+    }
+}
+
+void Dispatcher::dispatch_side(const canfd_frame &frame,
+                               const RxTimestamp timestamp) {
+    const auto side = side_funcs.read(REAP_READER);
+    if (frame.can_id & CAN_ERR_FLAG) {
+        bus_errors.record(frame, timestamp != RxTimestamp{}
+                                     ? timestamp
+                                     : std::chrono::system_clock::now());
+        for (const auto &subscriber : side->errors) {
+            subscriber.callback(frame, timestamp);
+        }
+        return;
+    }
+    if (auto *subscribers = side->remote.find(frame.can_id)) {
+        for (const auto &subscriber : *subscribers) {
+            subscriber.callback(frame, timestamp);
+        }
+    }
+}
+
+void Dispatcher::record_timing(const Subscribers &subscribers,
+                               const RxTimestamp timestamp,
+                               const RxTimestamp started,
+                               const RxTimestamp finished) {
+    // CLOCK_REALTIME may step backwards; count such a stage as zero.
+    const auto span = [](const RxTimestamp from, const RxTimestamp to) {
+        return to > from ? static_cast<uint64_t>((to - from).count()) : 0;
+    };
+    const std::array<uint64_t, 3> stages = {span(timestamp, rx_read_at),
+                                            span(rx_read_at, started),
+                                            span(started, finished)};
+    // Only the reap thread writes these, so plain load/store is enough.
+    stat_stage_frames.store(
+        stat_stage_frames.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+    for (size_t i = 0; i < stages.size(); ++i) {
+        stat_stage_total_ns[i].store(
+            stat_stage_total_ns[i].load(std::memory_order_relaxed) +
+                stages[i],
+            std::memory_order_relaxed);
+        if (stages[i] > stat_stage_max_ns[i].load(std::memory_order_relaxed)) {
+            stat_stage_max_ns[i].store(stages[i], std::memory_order_relaxed);
+        }
+    }
+    if (latency_recording.load(std::memory_order_relaxed)) {
+        const uint64_t latency = stages[0] + stages[1];
+        latency_histogram.record(latency);
+        if (subscribers.latency) {
+            subscribers.latency->record(latency);
         }
     }
 }
 
 tl::expected<void, Error>
-Dispatcher::epoll_fd_add_sock_fd(const int sock_fd) const noexcept {
+Dispatcher::epoll_fd_add_sock_fd(const int sock_fd,
+                                 const uint32_t events) const noexcept {
     epoll_event ev{};
-    ev = {.events = EPOLLIN, .data = {.fd = sock_fd}};
+    ev = {.events = events, .data = {.fd = sock_fd}};
     if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sock_fd, &ev) == -1) {
         return unexpected(Error{
             EpollError, format("Failed to EPOLL_CTL_ADD thread_event_fd: {}",
@@ -192,18 +794,463 @@ Dispatcher::epoll_fd_add_sock_fd(const int sock_fd) const noexcept {
     }
     return {};
 }
-#ifdef HYCAN_LATENCY_TEST
-Dispatcher::LatencyStats Dispatcher::get_latency_stats() const {
-    LatencyStats stats;
-    stats.total_latency_ns =
-        accumulated_latency_ns.load(std::memory_order_relaxed);
-    stats.message_count = latency_message_count.load(std::memory_order_relaxed);
-    if (stats.message_count > 0) {
-        stats.average_latency_us = static_cast<double>(stats.total_latency_ns) /
-                                   static_cast<double>(stats.message_count) /
-                                   1000.0;
+tl::expected<std::shared_ptr<const Mailbox>, Error>
+Dispatcher::register_mailbox(const std::set<size_t> &can_ids) {
+    if (auto res = check_ids(can_ids); !res) {
+        return tl::unexpected(res.error());
+    }
+    std::vector<canid_t> keys;
+    keys.reserve(can_ids.size());
+    for (const auto id : can_ids) {
+        keys.push_back(*to_table_key(id));
+    }
+    std::ranges::sort(keys);
+    const auto [first, last] = std::ranges::unique(keys);
+    keys.erase(first, last);
+    auto mailbox = std::make_shared<Mailbox>(keys);
+    return register_func<canfd_frame>(
+               can_ids,
+               [mailbox](const canfd_frame &frame,
+                         const RxTimestamp timestamp) {
+                   mailbox->write(frame, timestamp);
+               })
+        .map([&](const CallbackHandle handle) {
+            mailbox->handle_ = handle;
+            return std::shared_ptr<const Mailbox>(mailbox);
+        });
+}
+
+tl::expected<void, Error>
+Dispatcher::unregister_func(const std::set<size_t> &can_ids) {
+    return update_table([&](CallbackTable &table) {
+        for (const auto id : can_ids) {
+            const auto key = to_table_key(id);
+            if (!key) {
+                continue;
+            }
+            if (auto *subscribers = table.find_key(*key)) {
+                for (const auto &subscriber : *subscribers) {
+                    forget_subscription(subscriber.handle_id, *key);
+                }
+            }
+            table.erase(*key);
+            watchdog.unwatch_key(*key);
+        }
+    });
+}
+
+tl::expected<void, Error>
+Dispatcher::watch(const CallbackHandle handle, const std::set<size_t> &can_ids,
+                  const Freshness &freshness) {
+    std::vector<canid_t> keys;
+    keys.reserve(can_ids.size());
+    for (const auto id : can_ids) {
+        keys.push_back(*to_table_key(id));
+    }
+    // Point the entries at their slots first, so no frame goes unseen by
+    // the watch.
+    return update_table([&](CallbackTable &table) {
+               for (const canid_t key : keys) {
+                   if (auto *subscribers = table.find_key(key)) {
+                       subscribers->fresh = &watchdog.slot(key);
+                   }
+               }
+           })
+        .and_then([&] { return watchdog.watch(handle.id, keys, freshness); });
+}
+
+tl::expected<void, Error>
+Dispatcher::check_ids(const std::set<size_t> &can_ids) {
+    for (auto id : can_ids) {
+        if (!to_table_key(id)) {
+            return tl::unexpected(
+                Error{ErrorCode::FuncCANIdSetError,
+                      format("CAN ID {:#x} exceeds the 29-bit extended "
+                             "ID range",
+                             id)});
+        }
+    }
+    return {};
+}
+
+tl::expected<void, Error>
+Dispatcher::unregister_handle(const CallbackHandle handle) {
+    bool side = false;
+    {
+        std::lock_guard guard(table_mutex_);
+        const auto it = subscriptions.find(handle.id);
+        if (it == subscriptions.end()) {
+            return {};
+        }
+        // A handle's keys are all of one kind.
+        side = !it->second.empty() &&
+               (it->second.front() & (CAN_RTR_FLAG | CAN_ERR_FLAG));
+    }
+    if (side) {
+        return update_side([&](SideTable &table) {
+            const auto it = subscriptions.find(handle.id);
+            if (it == subscriptions.end()) {
+                return;
+            }
+            const auto owned = [&](const Subscriber &subscriber) {
+                return subscriber.handle_id == handle.id;
+            };
+            for (const canid_t key : it->second) {
+                if (key == CAN_ERR_FLAG) {
+                    table.errors.erase_if(owned);
+                    continue;
+                }
+                const canid_t remote_key = key & ~CAN_RTR_FLAG;
+                if (auto *subscribers = table.remote.find(remote_key)) {
+                    subscribers->erase_if(owned);
+                    if (subscribers->empty()) {
+                        table.remote.erase(remote_key);
+                    }
+                }
+            }
+            subscriptions.erase(it);
+        });
+    }
+    return update_table([&](CallbackTable &table) {
+        const auto it = subscriptions.find(handle.id);
+        if (it == subscriptions.end()) {
+            return;
+        }
+        const auto owned = [&](const Subscriber &subscriber) {
+            return subscriber.handle_id == handle.id;
+        };
+        std::vector<canid_t> keys = std::move(it->second);
+        subscriptions.erase(it);
+        watchdog.unwatch(handle.id);
+        if (mask_handles.erase(handle.id)) {
+            // Its callback may sit in any extended entry it covers.
+            table.for_each_key([&](const canid_t key) {
+                if (key & CAN_EFF_FLAG) {
+                    keys.push_back(key);
+                }
+            });
+            table.for_each_mask([&](canid_t, canid_t, Subscribers &entry) {
+                entry.erase_if(owned);
+            });
+            table.erase_masks_if(
+                [](const Subscribers &entry) { return entry.empty(); });
+        }
+        for (const canid_t key : keys) {
+            auto *subscribers = table.find_key(key);
+            if (!subscribers) {
+                continue;
+            }
+            subscribers->erase_if(owned);
+            if (subscribers->empty()) {
+                table.erase(key);
+            }
+        }
+    });
+}
+
+void Dispatcher::subscribe(CallbackTable &table, const canid_t key,
+                           const Subscriber &subscriber) {
+    const auto owned = [&](const Subscriber &existing) {
+        return existing.handle_id == subscriber.handle_id;
+    };
+    auto *subscribers = table.find_key(key);
+    if (!subscribers) {
+        subscribers = &table[key];
+        if (key & CAN_EFF_FLAG) {
+            if (const auto *cover =
+                    table.covering(key & CAN_EFF_MASK, CAN_EFF_MASK)) {
+                *subscribers = *cover;
+            }
+        }
+    } else if (std::ranges::any_of(*subscribers, owned)) {
+        return;
+    }
+    subscribers->emplace_back(subscriber.callback, subscriber.handle_id);
+    subscriptions[subscriber.handle_id].push_back(key);
+}
+
+void Dispatcher::subscribe_mask(CallbackTable &table, const canid_t id,
+                                const canid_t mask,
+                                const Subscriber &subscriber) {
+    const auto add = [&](Subscribers &subscribers) {
+        if (std::ranges::none_of(subscribers, [&](const Subscriber &existing) {
+                return existing.handle_id == subscriber.handle_id;
+            })) {
+            subscribers.emplace_back(subscriber.callback, subscriber.handle_id);
+        }
+    };
+    subscriptions[subscriber.handle_id];
+    mask_handles.insert(subscriber.handle_id);
+    // Entries for the block itself and its overlaps with existing blocks,
+    // each seeded with the blocks already covering it.
+    std::vector<std::pair<canid_t, canid_t>> created{{id, mask}};
+    table.for_each_mask([&](const canid_t other_id, const canid_t other_mask,
+                            Subscribers &) {
+        const canid_t common = mask & other_mask;
+        if ((id & common) == (other_id & common)) {
+            created.emplace_back(id | other_id, mask | other_mask);
+        }
+    });
+    for (const auto &[new_id, new_mask] : created) {
+        if (table.find_mask(new_id, new_mask)) {
+            continue;
+        }
+        const auto *cover = table.covering(new_id, new_mask);
+        Subscribers seed = cover ? *cover : Subscribers{};
+        table.insert_mask(new_id, new_mask) = std::move(seed);
+    }
+    // Every entry inside the block, id/mask or exact, gains the callback.
+    table.for_each_mask([&](const canid_t entry_id, const canid_t entry_mask,
+                            Subscribers &subscribers) {
+        if ((entry_mask & mask) == mask && (entry_id & mask) == id) {
+            add(subscribers);
+        }
+    });
+    table.for_each_key([&](const canid_t key) {
+        if ((key & CAN_EFF_FLAG) && (key & mask) == id) {
+            add(*table.find_key(key));
+        }
+    });
+}
+
+void Dispatcher::forget_subscription(const uint64_t handle_id,
+                                     const canid_t key) {
+    const auto it = subscriptions.find(handle_id);
+    if (it == subscriptions.end()) {
+        return;
+    }
+    std::erase(it->second, key);
+    // A mask handle keeps its bookkeeping until unregister_handle; its
+    // id/mask entries outlive any exact key it was copied into.
+    if (it->second.empty() && !mask_handles.contains(handle_id)) {
+        subscriptions.erase(it);
+    }
+}
+
+tl::expected<void, Error> Dispatcher::update_table(
+    const std::function<void(CallbackTable &)> &mutate) {
+    std::lock_guard guard(table_mutex_);
+    auto next = std::make_unique<CallbackTable>(funcs.current());
+    mutate(*next);
+    if (latency_recording.load(std::memory_order_relaxed)) {
+        attach_histograms(*next);
+    }
+    // Returns at once; the reap thread may still be reading the old table.
+    auto [old, epoch] = funcs.publish(std::move(next));
+    retire({std::move(old), nullptr, epoch});
+    return sync_kernel_filter();
+}
+
+tl::expected<void, Error> Dispatcher::update_side(
+    const std::function<void(SideTable &)> &mutate) {
+    std::lock_guard guard(table_mutex_);
+    auto next = std::make_unique<SideTable>(side_funcs.current());
+    mutate(*next);
+    auto [old, epoch] = side_funcs.publish(std::move(next));
+    retire({nullptr, std::move(old), epoch});
+    return sync_kernel_filter();
+}
+
+void Dispatcher::retire(RetiredTables old) {
+    retired.push_back(std::move(old));
+    reclaim();
+}
+
+void Dispatcher::reclaim() {
+    std::erase_if(retired, [this](RetiredTables &old) {
+        if (!old.worker_marks) {
+            if (!(old.table ? funcs.released(old.epoch)
+                            : side_funcs.released(old.epoch))) {
+                return false;
+            }
+            if (!workers) {
+                return true;
+            }
+            // The reap thread can no longer queue tasks from the old
+            // table, but those already queued may point into it, and the
+            // caller may be one of them, running on a worker.
+            old.worker_marks = workers->marks();
+        }
+        return workers->passed(*old.worker_marks);
+    });
+    retire_pending.store(!retired.empty(), std::memory_order_relaxed);
+}
+
+void Dispatcher::try_reclaim() {
+    if (!retire_pending.load(std::memory_order_relaxed)) [[likely]] {
+        return;
+    }
+    // Never waits for a writer; the next drain or update tries again.
+    if (std::unique_lock lock(table_mutex_, std::try_to_lock); lock) {
+        reclaim();
+    }
+}
+
+tl::expected<void, Error> Dispatcher::sync_kernel_filter() {
+    if (!options.kernel_filter) {
+        return {};
+    }
+    std::vector<canid_t> keys;
+    const auto collect = [&](const canid_t key) { keys.push_back(key); };
+    funcs.current().for_each_key(collect);
+    // The filter masks ignore CAN_RTR_FLAG, so data and remote frames of
+    // an admitted ID both pass.
+    side_funcs.current().remote.for_each_key(collect);
+    keys.insert(keys.end(), static_keys.begin(), static_keys.end());
+    {
+        std::lock_guard guard(awaited_mutex_);
+        for (const auto &[key, count] : awaited_keys) {
+            keys.push_back(key);
+        }
+    }
+    std::ranges::sort(keys);
+    const auto [first, last] = std::ranges::unique(keys);
+    keys.erase(first, last);
+    std::vector<can_filter> masks;
+    funcs.current().for_each_mask(
+        [&](const canid_t id, const canid_t mask, const Subscribers &) {
+            masks.push_back({.can_id = id | CAN_EFF_FLAG,
+                             .can_mask = mask | CAN_EFF_FLAG});
+        });
+    // id/mask entries map onto filters as they are; the IDs share the rest.
+    auto filters = build_can_filters(
+        keys, options.max_kernel_filters > masks.size()
+                  ? options.max_kernel_filters - masks.size()
+                  : 0);
+    filters.insert(filters.end(), masks.begin(), masks.end());
+    return socket.set_filters(filters);
+}
+
+void Dispatcher::attach_histograms(CallbackTable &table) {
+    table.for_each_key([&](const canid_t key) {
+        auto &histogram = latency_by_id[key];
+        if (!histogram) {
+            histogram = std::make_unique<Util::LatencyHistogram>();
+        }
+        table.find(key)->latency = histogram.get();
+    });
+}
+
+tl::expected<void, Error>
+Dispatcher::set_latency_recording(const bool enabled) {
+    {
+        std::lock_guard guard(table_mutex_);
+        const bool stamping = enabled || options.rx_timestamps;
+        if (auto res = socket.set_timestamps(stamping || traffic); !res) {
+            return res;
+        }
+        rx_stamping.store(stamping, std::memory_order_relaxed);
+        latency_recording.store(enabled, std::memory_order_relaxed);
+    }
+    if (!enabled) {
+        return {};
+    }
+    // Republish the table with histograms attached.
+    return update_table([](CallbackTable &) {});
+}
+
+Util::LatencySnapshot Dispatcher::get_latency() const noexcept {
+    return latency_histogram.snapshot();
+}
+
+std::optional<Util::LatencySnapshot>
+Dispatcher::get_latency(const size_t can_id) const {
+    const auto key = to_table_key(can_id);
+    if (!key) {
+        return std::nullopt;
+    }
+    std::lock_guard guard(table_mutex_);
+    const auto it = latency_by_id.find(*key);
+    if (it == latency_by_id.end()) {
+        return std::nullopt;
+    }
+    return it->second->snapshot();
+}
+
+std::vector<IdTrafficStats> Dispatcher::get_id_stats() const {
+    return traffic ? traffic->snapshot() : std::vector<IdTrafficStats>{};
+}
+
+std::optional<IdTrafficStats>
+Dispatcher::get_id_stats(const size_t can_id) const {
+    const auto key = to_table_key(can_id);
+    if (!key || !traffic) {
+        return std::nullopt;
+    }
+    return traffic->snapshot(*key);
+}
+
+void Dispatcher::reset_latency() {
+    std::lock_guard guard(table_mutex_);
+    latency_histogram.reset();
+    for (const auto &[key, histogram] : latency_by_id) {
+        histogram->reset();
+    }
+}
+
+Dispatcher::Callback Dispatcher::defer(Callback callback,
+                                       const uint64_t handle_id) {
+    if (!workers) {
+        workers = std::make_unique<WorkerPool>(options.deferred_workers,
+                                               options.deferred_queue_depth);
+    }
+    // Consecutive registrations are spread round-robin over the workers;
+    // all frames of one callback go to the same worker, in order.
+    return DeferredCallback(*workers, handle_id % workers->size(),
+                            std::move(callback));
+}
+
+std::optional<canid_t> Dispatcher::to_table_key(const size_t can_id) noexcept {
+    if (can_id & CAN_EFF_FLAG) {
+        if ((can_id & ~static_cast<size_t>(CAN_EFF_FLAG)) > CAN_EFF_MASK) {
+            return std::nullopt;
+        }
+        return static_cast<canid_t>(can_id);
+    }
+    if (can_id <= CAN_SFF_MASK) {
+        return static_cast<canid_t>(can_id);
+    }
+    if (can_id <= CAN_EFF_MASK) {
+        return static_cast<canid_t>(can_id) | CAN_EFF_FLAG;
+    }
+    return std::nullopt;
+}
+
+Dispatcher::ReceiveStats Dispatcher::get_receive_stats() const noexcept {
+    ReceiveStats stats{
+        .wakeups = stat_wakeups.load(std::memory_order_relaxed),
+        .receive_calls = stat_receive_calls.load(std::memory_order_relaxed),
+        .frames = stat_frames.load(std::memory_order_relaxed),
+        .budget_exhausted =
+            stat_budget_exhausted.load(std::memory_order_relaxed),
+        .max_wakeup_frames =
+            stat_max_wakeup_frames.load(std::memory_order_relaxed),
+        .kernel_drops = stat_kernel_drops.load(std::memory_order_relaxed),
+    };
+    for (size_t i = 0; i < DRAIN_HISTOGRAM_BUCKETS; ++i) {
+        stats.wakeup_frames_histogram[i] =
+            stat_drain_histogram[i].load(std::memory_order_relaxed);
     }
     return stats;
 }
-#endif
+
+Dispatcher::StageStats Dispatcher::get_stage_stats() const noexcept {
+    const auto stage = [&](const size_t i) {
+        return StageTime{
+            .total_ns = stat_stage_total_ns[i].load(std::memory_order_relaxed),
+            .max_ns = stat_stage_max_ns[i].load(std::memory_order_relaxed),
+        };
+    };
+    return {
+        .frames = stat_stage_frames.load(std::memory_order_relaxed),
+        .kernel_to_read = stage(0),
+        .read_to_callback = stage(1),
+        .callback = stage(2),
+    };
+}
+
+std::vector<DeferredStats> Dispatcher::get_deferred_stats() const {
+    std::lock_guard guard(table_mutex_);
+    return workers ? workers->stats() : std::vector<DeferredStats>{};
+}
 } // namespace HyCAN
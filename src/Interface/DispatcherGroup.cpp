@@ -0,0 +1,173 @@
+#include "HyCAN/Interface/DispatcherGroup.hpp"
+#include "HyCAN/Interface/Dispatcher.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <format>
+
+using tl::unexpected, std::format;
+using enum HyCAN::ErrorCode;
+
+namespace {
+// A dispatcher's watchdog timer carries the dispatcher pointer with the
+// low bit set; its socket carries the plain pointer.
+constexpr uintptr_t WATCHDOG_TAG = 1;
+
+void *watchdog_tag(HyCAN::Dispatcher &dispatcher) noexcept {
+    return reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(&dispatcher) |
+                                    WATCHDOG_TAG);
+}
+} // namespace
+
+namespace HyCAN {
+DispatcherGroup::DispatcherGroup(const std::optional<uint8_t> &cpu_core_opt) {
+    epoll_fd = epoll_create1(0);
+    if (epoll_fd == -1) {
+        throw std::runtime_error(format(
+            "Failed to create epoll file descriptor: {}", strerror(errno)));
+    }
+    thread_event_fd = eventfd(0, 0);
+    if (thread_event_fd == -1) {
+        close(epoll_fd);
+        throw std::runtime_error(
+            format("Failed to create thread_event_fd file descriptor: {}",
+                   strerror(errno)));
+    }
+    // A null pointer marks the eventfd; sockets carry their dispatcher.
+    epoll_event ev{.events = EPOLLIN, .data = {.ptr = nullptr}};
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, thread_event_fd, &ev) == -1) {
+        close(thread_event_fd);
+        close(epoll_fd);
+        throw std::runtime_error(
+            format("Failed to EPOLL_CTL_ADD thread_event_fd: {}",
+                   strerror(errno)));
+    }
+    cpu_core = cpu_core_opt.has_value() ? cpu_core_opt.value()
+                                        : Dispatcher::next_cpu_core();
+}
+
+DispatcherGroup::~DispatcherGroup() {
+    if (reap_thread.joinable()) {
+        reap_thread.request_stop();
+        constexpr uint64_t one = 1;
+        (void)write(thread_event_fd, &one, sizeof(one));
+        reap_thread.join();
+    }
+    close(epoll_fd);
+    close(thread_event_fd);
+}
+
+size_t DispatcherGroup::size() const {
+    std::lock_guard guard(mutex_);
+    return members.size();
+}
+
+tl::expected<void, Error> DispatcherGroup::attach(Dispatcher &dispatcher) {
+    std::lock_guard guard(mutex_);
+    if (std::ranges::find(members, &dispatcher) != members.end()) {
+        return {};
+    }
+    epoll_event ev{.events = EPOLLIN, .data = {.ptr = &dispatcher}};
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, dispatcher.socket.get_sock_fd(),
+                  &ev) == -1) {
+        return unexpected(Error{
+            EpollError, format("Failed to EPOLL_CTL_ADD socket of '{}': {}",
+                               dispatcher.interface_name, strerror(errno))});
+    }
+    ev = {.events = EPOLLIN, .data = {.ptr = watchdog_tag(dispatcher)}};
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, dispatcher.watchdog.fd(), &ev) ==
+        -1) {
+        const int err = errno;
+        (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL,
+                        dispatcher.socket.get_sock_fd(), nullptr);
+        return unexpected(Error{
+            EpollError, format("Failed to EPOLL_CTL_ADD watchdog of '{}': {}",
+                               dispatcher.interface_name, strerror(err))});
+    }
+    members.push_back(&dispatcher);
+    if (!reap_thread.joinable()) {
+        reap_thread = std::jthread([this](const std::stop_token &stop_token) {
+            reap_process(stop_token);
+        });
+    }
+    return {};
+}
+
+tl::expected<void, Error> DispatcherGroup::detach(Dispatcher &dispatcher) {
+    {
+        std::lock_guard guard(mutex_);
+        const auto it = std::ranges::find(members, &dispatcher);
+        if (it == members.end()) {
+            return {};
+        }
+        members.erase(it);
+        // The socket may already be closed, which removed it from the set.
+        (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL,
+                        dispatcher.socket.get_sock_fd(), nullptr);
+        (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL, dispatcher.watchdog.fd(),
+                        nullptr);
+        if (std::this_thread::get_id() == reap_thread.get_id()) {
+            // Called from a callback: the current pass is the caller's own.
+            return {};
+        }
+    }
+    // Waited for without the lock: a callback in the pass may itself
+    // attach or detach another member.
+    // Events fetched before the removal may still name this dispatcher;
+    // they are used up once the pass in flight completes.
+    const uint64_t pass = passes.load(std::memory_order_acquire);
+    constexpr uint64_t one = 1;
+    if (write(thread_event_fd, &one, sizeof(one)) == -1) {
+        return unexpected(Error{
+            ReaperStopError,
+            format("Failed to write one bytes to the specified socket: {}",
+                   strerror(errno))});
+    }
+    while (passes.load(std::memory_order_acquire) == pass) {
+        std::this_thread::yield();
+    }
+    return {};
+}
+
+void DispatcherGroup::reap_process(const std::stop_token &stop_token) {
+    Dispatcher::prepare_reap_thread(cpu_core);
+    epoll_event events[MAX_EPOLL_EVENT]{};
+    while (true) {
+        const int nfds = epoll_wait(epoll_fd, events, MAX_EPOLL_EVENT, -1);
+        if (nfds == -1) {
+            if (errno == EINTR && !stop_token.stop_requested()) {
+                continue;
+            }
+            if (!stop_token.stop_requested()) {
+                throw std::runtime_error(
+                    format("Failed to epoll_wait: {}", strerror(errno)));
+            }
+            return;
+        }
+        for (int i = 0; i < nfds; ++i) {
+            const auto tagged = reinterpret_cast<uintptr_t>(events[i].data.ptr);
+            auto *dispatcher =
+                reinterpret_cast<Dispatcher *>(tagged & ~WATCHDOG_TAG);
+            if (!dispatcher) {
+                if (stop_token.stop_requested())
+                    return;
+                uint64_t value;
+                (void)read(thread_event_fd, &value, sizeof(value));
+                continue;
+            }
+            if (tagged & WATCHDOG_TAG) {
+                dispatcher->watchdog.expire(std::chrono::steady_clock::now());
+                continue;
+            }
+            // Each socket gets at most its wakeup_budget per pass, so one
+            // busy bus cannot hold up the others.
+            (void)dispatcher->drain(dispatcher->socket.get_sock_fd());
+        }
+        passes.fetch_add(1, std::memory_order_release);
+    }
+}
+} // namespace HyCAN
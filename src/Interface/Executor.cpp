@@ -0,0 +1,276 @@
+#include "HyCAN/Interface/Executor.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+using tl::unexpected, std::format;
+using enum HyCAN::ErrorCode;
+
+namespace HyCAN {
+namespace {
+thread_local Executor *running = nullptr;
+
+constexpr int MAX_EVENTS = 16;
+} // namespace
+
+Executor::Executor() {
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    // steady_clock is CLOCK_MONOTONIC.
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (epoll_fd == -1 || wake_fd == -1 || timer_fd == -1) {
+        const int err = errno;
+        for (const int fd : {epoll_fd, wake_fd, timer_fd}) {
+            if (fd != -1) {
+                close(fd);
+            }
+        }
+        throw std::runtime_error(
+            format("Failed to create executor descriptors: {}",
+                   strerror(err)));
+    }
+    for (const int fd : {wake_fd, timer_fd}) {
+        epoll_event ev{.events = EPOLLIN, .data = {.fd = fd}};
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+            const int err = errno;
+            close(timer_fd);
+            close(wake_fd);
+            close(epoll_fd);
+            throw std::runtime_error(format(
+                "Failed to EPOLL_CTL_ADD executor fd: {}", strerror(err)));
+        }
+    }
+}
+
+Executor::~Executor() {
+    // Destroying a task also destroys the tasks and awaiters it is
+    // suspended in, which cancel their timers and waits.
+    for (void *task : std::exchange(tasks, {})) {
+        std::coroutine_handle<>::from_address(task).destroy();
+    }
+    close(timer_fd);
+    close(wake_fd);
+    close(epoll_fd);
+}
+
+Executor *Executor::current() noexcept { return running; }
+
+tl::expected<void, Error> Executor::run() {
+    Executor *const outer = std::exchange(running, this);
+    tl::expected<void, Error> result{};
+    std::vector<std::coroutine_handle<>> batch;
+    while (!stop_requested.load(std::memory_order_acquire) && !failure) {
+        {
+            std::lock_guard guard(ready_lock);
+            if (tasks.empty()) {
+                break;
+            }
+            batch.swap(ready);
+        }
+        for (const auto handle : batch) {
+            handle.resume();
+        }
+        batch.clear();
+        fire_timers();
+        if (auto res = wait_events(); !res) {
+            result = res;
+            break;
+        }
+    }
+    running = outer;
+    stop_requested.store(false, std::memory_order_relaxed);
+    if (failure) {
+        std::rethrow_exception(std::exchange(failure, nullptr));
+    }
+    return result;
+}
+
+void Executor::stop() noexcept {
+    stop_requested.store(true, std::memory_order_release);
+    constexpr uint64_t one = 1;
+    (void)write(wake_fd, &one, sizeof(one));
+}
+
+void Executor::post(const std::coroutine_handle<> handle) {
+    {
+        std::lock_guard guard(ready_lock);
+        ready.push_back(handle);
+    }
+    wake();
+}
+
+void Executor::wake() noexcept {
+    // Pairs with wait_events(): either it sees the new entry before
+    // sleeping, or this sees it asleep.
+    if (sleeping.exchange(false, std::memory_order_seq_cst)) {
+        constexpr uint64_t one = 1;
+        (void)write(wake_fd, &one, sizeof(one));
+    }
+}
+
+void Executor::finish(const std::coroutine_handle<> task,
+                      const std::exception_ptr &exception) noexcept {
+    if (exception && !failure) {
+        failure = exception;
+    }
+    {
+        std::lock_guard guard(ready_lock);
+        tasks.erase(task.address());
+    }
+    task.destroy();
+}
+
+tl::expected<void, Error> Executor::wait_events() {
+    if (!timers.empty() && timers.begin()->first != armed_deadline) {
+        armed_deadline = timers.begin()->first;
+        const auto since_epoch = armed_deadline.time_since_epoch();
+        const auto seconds =
+            std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+        itimerspec spec{};
+        spec.it_value.tv_sec = seconds.count();
+        spec.it_value.tv_nsec =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch -
+                                                                 seconds)
+                .count();
+        // A zero it_value would disarm the timer instead.
+        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+            spec.it_value.tv_nsec = 1;
+        }
+        if (timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr) ==
+            -1) {
+            return unexpected(Error{
+                ExecutorError,
+                format("Failed to arm executor timer: {}", strerror(errno))});
+        }
+    }
+    sleeping.store(true, std::memory_order_seq_cst);
+    {
+        std::lock_guard guard(ready_lock);
+        if (!ready.empty() || tasks.empty()) {
+            sleeping.store(false, std::memory_order_relaxed);
+            return {};
+        }
+    }
+    std::array<epoll_event, MAX_EVENTS> events{};
+    const int count = epoll_wait(epoll_fd, events.data(), MAX_EVENTS, -1);
+    sleeping.store(false, std::memory_order_relaxed);
+    if (count == -1) {
+        if (errno == EINTR) {
+            return {};
+        }
+        return unexpected(
+            Error{EpollError, format("Executor epoll_wait failed: {}",
+                                     strerror(errno))});
+    }
+    for (int i = 0; i < count; ++i) {
+        const int fd = events[static_cast<size_t>(i)].data.fd;
+        if (fd == wake_fd || fd == timer_fd) {
+            uint64_t value;
+            (void)read(fd, &value, sizeof(value));
+            if (fd == timer_fd) {
+                armed_deadline = Clock::time_point::max();
+            }
+        } else {
+            fire_writable(fd);
+        }
+    }
+    return {};
+}
+
+Executor::TimerId Executor::add_timer(const Clock::time_point deadline,
+                                      const Wakeup wakeup, void *context) {
+    return timers.emplace(deadline, Timer{wakeup, context});
+}
+
+void Executor::cancel_timer(const TimerId timer) { timers.erase(timer); }
+
+void Executor::fire_timers() {
+    const auto now = Clock::now();
+    // Wakeups may add and cancel timers, so start over from the front.
+    while (!timers.empty() && timers.begin()->first <= now) {
+        const Timer timer = timers.begin()->second;
+        timers.erase(timers.begin());
+        timer.wakeup(timer.context, false);
+    }
+}
+
+tl::expected<void, Error>
+Executor::wait_writable(const int fd, const Clock::time_point deadline,
+                        const Wakeup wakeup, void *context) {
+    const bool watched = std::ranges::any_of(
+        fd_waits, [fd](const FdWait &wait) { return wait.fd == fd; });
+    if (!watched) {
+        epoll_event ev{.events = EPOLLOUT, .data = {.fd = fd}};
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+            return unexpected(Error{
+                EpollError, format("Failed to EPOLL_CTL_ADD fd {}: {}", fd,
+                                   strerror(errno))});
+        }
+    }
+    auto &wait = fd_waits.emplace_back(FdWait{fd, wakeup, context, {}});
+    if (deadline != Clock::time_point::max()) {
+        wait.timer = add_timer(deadline, &Executor::writable_expired, &wait);
+    }
+    return {};
+}
+
+void Executor::cancel_writable(void *context) {
+    const auto wait = std::ranges::find_if(
+        fd_waits, [context](const FdWait &w) { return w.context == context; });
+    if (wait != fd_waits.end()) {
+        if (wait->timer) {
+            timers.erase(*wait->timer);
+        }
+        drop_fd_wait(wait);
+    }
+}
+
+void Executor::writable_expired(void *context, bool) {
+    auto *wait = static_cast<FdWait *>(context);
+    Executor &executor = *running;
+    const auto it = std::ranges::find_if(
+        executor.fd_waits, [wait](const FdWait &w) { return &w == wait; });
+    const Wakeup wakeup = it->wakeup;
+    void *const target = it->context;
+    executor.drop_fd_wait(it);
+    wakeup(target, false);
+}
+
+void Executor::fire_writable(const int fd) {
+    // Collect first: wakeups may wait on the fd again.
+    std::vector<Timer> woken;
+    for (auto it = fd_waits.begin(); it != fd_waits.end();) {
+        const auto next = std::next(it);
+        if (it->fd == fd) {
+            if (it->timer) {
+                timers.erase(*it->timer);
+            }
+            woken.push_back({it->wakeup, it->context});
+            drop_fd_wait(it);
+        }
+        it = next;
+    }
+    for (const auto &[wakeup, context] : woken) {
+        wakeup(context, true);
+    }
+}
+
+void Executor::drop_fd_wait(const std::list<FdWait>::iterator wait) {
+    const int fd = wait->fd;
+    fd_waits.erase(wait);
+    const bool watched = std::ranges::any_of(
+        fd_waits, [fd](const FdWait &w) { return w.fd == fd; });
+    if (!watched) {
+        (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+} // namespace HyCAN
@@ -47,7 +47,8 @@ namespace HyCAN
         }
     }
 
-    tl::expected<void, Error> IPCManager::set(const std::string_view interface_name, const bool up, const uint32_t bitrate)
+    tl::expected<void, Error> IPCManager::set(const std::string_view interface_name, const bool up, const uint32_t bitrate,
+                                              const uint32_t data_bitrate)
     {
         auto init_result = ensure_initialized();
         if (!init_result)
@@ -55,7 +56,7 @@ namespace HyCAN
             return unexpected(init_result.error());
         }
 
-        return client_->set_interface_state(interface_name, up, bitrate);
+        return client_->set_interface_state(interface_name, up, bitrate, data_bitrate);
     }
 
     tl::expected<bool, Error> IPCManager::exists(std::string_view interface_name)
@@ -0,0 +1,98 @@
+#include "HyCAN/Interface/IdPattern.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <format>
+#include <optional>
+
+namespace HyCAN {
+namespace {
+// Same rules as single IDs: standard up to 0x7FF, extended keys carry
+// CAN_EFF_FLAG.
+std::optional<canid_t> to_key(const size_t id) {
+    const size_t bare = id & ~static_cast<size_t>(CAN_EFF_FLAG);
+    if (bare > CAN_EFF_MASK) {
+        return std::nullopt;
+    }
+    if ((id & CAN_EFF_FLAG) || bare > CAN_SFF_MASK) {
+        return static_cast<canid_t>(bare) | CAN_EFF_FLAG;
+    }
+    return static_cast<canid_t>(bare);
+}
+
+tl::unexpected<Error> invalid(const IdPattern &pattern, const char *reason) {
+    return tl::unexpected(Error{
+        ErrorCode::FuncCANIdSetError,
+        pattern.masked
+            ? std::format("ID pattern {:#x}/{:#x} {}", pattern.id,
+                          pattern.mask, reason)
+            : std::format("ID range {:#x}-{:#x} {}", pattern.id, pattern.last,
+                          reason)});
+}
+
+// Adds every ID of the block `base` | any combination of `free` bits.
+void add_block(CompiledIdPatterns &out, const canid_t base, const canid_t free,
+               const bool extended) {
+    constexpr auto max_bits =
+        static_cast<int>(CompiledIdPatterns::MAX_EXPANDED_BITS);
+    if (extended && std::popcount(free) > max_bits) {
+        out.masks.emplace_back(base, CAN_EFF_MASK & ~free);
+        return;
+    }
+    const canid_t flag = extended ? CAN_EFF_FLAG : 0;
+    // Walks the subsets of `free` in increasing order, back round to 0.
+    canid_t subset = 0;
+    do {
+        out.keys.push_back(base | subset | flag);
+        subset = (subset - free) & free;
+    } while (subset != 0);
+}
+} // namespace
+
+tl::expected<CompiledIdPatterns, Error>
+compile_id_patterns(const std::span<const IdPattern> patterns) {
+    CompiledIdPatterns out;
+    for (const auto &pattern : patterns) {
+        const auto key = to_key(pattern.id);
+        if (!key) {
+            return invalid(pattern, "exceeds the 29-bit extended ID range");
+        }
+        const bool extended = *key & CAN_EFF_FLAG;
+        const canid_t id_bits = extended ? CAN_EFF_MASK : CAN_SFF_MASK;
+        if (pattern.masked) {
+            const canid_t mask = pattern.mask & id_bits;
+            add_block(out, *key & mask, id_bits & ~mask, extended);
+            continue;
+        }
+        const auto last = to_key(pattern.last);
+        if (!last) {
+            return invalid(pattern, "exceeds the 29-bit extended ID range");
+        }
+        if ((*last & CAN_EFF_FLAG) != (*key & CAN_EFF_FLAG)) {
+            return invalid(pattern, "mixes standard and extended IDs");
+        }
+        uint64_t first = *key & id_bits;
+        const uint64_t end = (*last & id_bits) + uint64_t{1};
+        if (first >= end) {
+            return invalid(pattern, "runs backwards");
+        }
+        // Split into the largest aligned power-of-two blocks.
+        while (first < end) {
+            auto bits = static_cast<unsigned>(
+                first == 0 ? 29 : std::countr_zero(first));
+            while ((uint64_t{1} << bits) > end - first) {
+                --bits;
+            }
+            add_block(out, static_cast<canid_t>(first),
+                      static_cast<canid_t>((uint64_t{1} << bits) - 1),
+                      extended);
+            first += uint64_t{1} << bits;
+        }
+    }
+    std::ranges::sort(out.keys);
+    const auto [first, last] = std::ranges::unique(out.keys);
+    out.keys.erase(first, last);
+    return out;
+}
+} // namespace HyCAN
@@ -7,15 +7,27 @@ namespace HyCAN
 {
     template <InterfaceType Type>
     Interface<Type>::Interface(const string& interface_name,
-                               const std::optional<uint8_t>& cpu_core_opt)
+                               const std::optional<uint8_t>& cpu_core_opt,
+                               const DispatcherOptions& dispatcher_options)
                                      : interface_name(string(interface_name)),
-                                       dispatcher(this->interface_name, cpu_core_opt),
-                                       sender(this->interface_name)
+                                       dispatcher(this->interface_name, cpu_core_opt, dispatcher_options),
+                                       sender(this->interface_name),
+                                       cyclic_sender(this->interface_name)
     {
     }
 
     template <InterfaceType Type>
-    tl::expected<void, Error> Interface<Type>::up(const uint32_t bitrate)
+    Interface<Type>::Interface(const string& interface_name, DispatcherGroup& group,
+                               const DispatcherOptions& dispatcher_options)
+                                     : interface_name(string(interface_name)),
+                                       dispatcher(this->interface_name, group, dispatcher_options),
+                                       sender(this->interface_name),
+                                       cyclic_sender(this->interface_name)
+    {
+    }
+
+    template <InterfaceType Type>
+    tl::expected<void, Error> Interface<Type>::up(const uint32_t bitrate, const uint32_t data_bitrate)
     {
         if constexpr (Type == InterfaceType::VCAN)
         {
@@ -54,7 +66,7 @@ namespace HyCAN
             }
         }
 
-        return IPCManager::instance().set(interface_name, true, bitrate)
+        return IPCManager::instance().set(interface_name, true, bitrate, data_bitrate)
                                      .and_then([&] { return dispatcher.start(); });
     }
 
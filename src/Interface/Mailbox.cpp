@@ -0,0 +1,54 @@
+#include "HyCAN/Interface/Mailbox.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace HyCAN {
+Mailbox::Mailbox(const std::span<const canid_t> keys)
+    : keys(keys.begin(), keys.end()),
+      slots(std::make_unique<Slot[]>(keys.size())) {}
+
+size_t Mailbox::find(const size_t can_id) const noexcept {
+    const auto key = Dispatcher::to_table_key(can_id);
+    if (!key) {
+        return NOT_FOUND;
+    }
+    const auto it = std::ranges::lower_bound(keys, *key);
+    if (it == keys.end() || *it != *key) {
+        return NOT_FOUND;
+    }
+    return static_cast<size_t>(it - keys.begin());
+}
+
+std::optional<MailboxSample>
+Mailbox::read(const size_t can_id) const noexcept {
+    const size_t index = find(can_id);
+    if (index == NOT_FOUND) {
+        return std::nullopt;
+    }
+    uint64_t sequence = 0;
+    const Value value = slots[index].value.load(sequence);
+    if (sequence == 0) {
+        return std::nullopt;
+    }
+    return MailboxSample{value.frame, value.timestamp, sequence};
+}
+
+uint64_t Mailbox::sequence(const size_t can_id) const noexcept {
+    const size_t index = find(can_id);
+    return index == NOT_FOUND ? 0 : slots[index].value.stores();
+}
+
+void Mailbox::write(const canfd_frame &frame,
+                    RxTimestamp timestamp) noexcept {
+    // Only subscribed IDs are dispatched here.
+    const size_t index = find(frame.can_id);
+    if (index == NOT_FOUND) {
+        return;
+    }
+    if (timestamp == RxTimestamp{}) {
+        timestamp = std::chrono::system_clock::now();
+    }
+    slots[index].value.store({frame, timestamp});
+}
+} // namespace HyCAN
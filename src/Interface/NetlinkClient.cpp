@@ -127,15 +127,19 @@ namespace HyCAN
     }
 
     tl::expected<void, Error> NetlinkClient::fallback_system_call(std::string_view interface_name, const bool state,
-                                                                  const uint32_t bitrate)
+                                                                  const uint32_t bitrate, const uint32_t data_bitrate)
     {
         std::string command;
         if (state)
         {
             if (interface_name.starts_with("can"))
             {
-                const std::string bitrate_cmd = std::format("sudo ip link set {} type can bitrate {}",
-                                                            interface_name, bitrate);
+                std::string bitrate_cmd = std::format("sudo ip link set {} type can bitrate {}",
+                                                      interface_name, bitrate);
+                if (data_bitrate != 0)
+                {
+                    bitrate_cmd += std::format(" dbitrate {} fd on", data_bitrate);
+                }
                 if (const int bitrate_result = std::system(bitrate_cmd.c_str()); bitrate_result != 0)
                 {
                     return unexpected(Error{
@@ -165,15 +169,15 @@ namespace HyCAN
     }
 
     tl::expected<void, Error> NetlinkClient::set_interface_state(const std::string_view interface_name, const bool up,
-                                                                 const uint32_t bitrate)
+                                                                 const uint32_t bitrate, const uint32_t data_bitrate)
     {
         const bool is_can_interface = interface_name.starts_with("can");
-        const NetlinkRequest request{interface_name, up, is_can_interface && up, bitrate};
+        const NetlinkRequest request{interface_name, up, is_can_interface && up, bitrate, data_bitrate};
 
         auto response_result = send_request(request);
         if (!response_result)
         {
-            return fallback_system_call(interface_name, up, bitrate);
+            return fallback_system_call(interface_name, up, bitrate, data_bitrate);
         }
 
         const auto& response = response_result.value();
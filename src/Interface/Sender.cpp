@@ -1,6 +1,135 @@
 #include "HyCAN/Interface/Sender.hpp"
+#include "HyCAN/Util/CpuRelax.hpp"
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <thread>
 
 namespace HyCAN {
 Sender::Sender(const std::string_view interface_name)
     : socket(interface_name), interface_name(interface_name) {}
+
+BatchSendResult Sender::send_frames(const void *frames, const size_t count,
+                                    const size_t frame_size) noexcept {
+    std::array<iovec, MAX_BATCH_FRAMES> iovecs;
+    std::array<mmsghdr, MAX_BATCH_FRAMES> msgs{};
+    const auto *bytes = static_cast<const char *>(frames);
+    BatchSendResult result;
+    bool reconnected = false;
+    while (result.sent < count) {
+        const auto want = static_cast<unsigned>(
+            std::min(count - result.sent, MAX_BATCH_FRAMES));
+        for (unsigned i = 0; i < want; ++i) {
+            iovecs[i] = {.iov_base = const_cast<char *>(
+                             bytes + (result.sent + i) * frame_size),
+                         .iov_len = frame_size};
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        // Only fails outright if the first frame of the call was refused;
+        // a later refusal shows as a short count and is seen on the next
+        // call.
+        const int sent = sendmmsg(socket.get_sock_fd(), msgs.data(), want, 0);
+        if (sent > 0) {
+            result.sent += static_cast<size_t>(sent);
+            continue;
+        }
+        const int err = errno;
+        const bool is_fatal = err == EBADF || err == ENETDOWN ||
+                              err == EPIPE || err == ENXIO || err == ENODEV;
+        if (is_fatal && !reconnected) {
+            reconnected = true;
+            if (auto res = socket.ensure_connected(); !res) {
+                result.status = tl::unexpected(res.error());
+                return result;
+            }
+            continue;
+        }
+        if (err == EAGAIN || err == EWOULDBLOCK || err == ENOBUFS) {
+            result.status = tl::make_unexpected(
+                Error{ErrorCode::CANSocketBufferFull,
+                      std::format("CAN socket buffer full after {} of {} "
+                                  "frames",
+                                  result.sent, count)});
+        } else {
+            result.status = tl::make_unexpected(Error{
+                ErrorCode::CANSocketWriteError,
+                std::format("Failed to send CAN message {} of {}: {} "
+                            "(errno: {})",
+                            result.sent, count, strerror(err), err)});
+        }
+        return result;
+    }
+    return result;
+}
+
+bool Sender::wait_for_room(const Clock::time_point start,
+                           const Clock::time_point deadline,
+                           const std::chrono::nanoseconds spin,
+                           bool &writable) const noexcept {
+    const auto now = Clock::now();
+    if (now >= deadline) {
+        return false;
+    }
+    if (now - start < spin) {
+        Util::cpu_relax();
+        return true;
+    }
+    if (writable) {
+        // Room in the socket but not in the device queue.
+        writable = false;
+        std::this_thread::sleep_for(std::min<Clock::duration>(
+            deadline - now, RETRY_INTERVAL));
+        return true;
+    }
+    // POLLOUT only comes once the send buffer is half empty, while a frame
+    // fits as soon as one frame's worth drains, so the send is also
+    // retried every POLL_SLICE.
+    const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::min<Clock::duration>(deadline - now, POLL_SLICE));
+    const auto seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(remaining);
+    const timespec timeout{.tv_sec = seconds.count(),
+                           .tv_nsec = (remaining - seconds).count()};
+    pollfd pfd{.fd = socket.get_sock_fd(), .events = POLLOUT, .revents = 0};
+    const int ready = ppoll(&pfd, 1, &timeout, nullptr);
+    if (ready == -1 && errno != EINTR) {
+        // Nothing to wait on; fall back to pacing the retries.
+        std::this_thread::sleep_for(std::min<Clock::duration>(
+            deadline - now, RETRY_INTERVAL));
+    }
+    writable = ready > 0;
+    return true;
+}
+
+void Sender::record_blocked(const Clock::time_point start,
+                            const std::chrono::nanoseconds spin,
+                            const tl::expected<void, Error> &result) noexcept {
+    const auto blocked = Clock::now() - start;
+    const auto ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(blocked).count());
+    stat_full.fetch_add(1, std::memory_order_relaxed);
+    if (buffer_full(result)) {
+        stat_timeouts.fetch_add(1, std::memory_order_relaxed);
+    } else if (result && blocked < spin) {
+        stat_spun.fetch_add(1, std::memory_order_relaxed);
+    }
+    stat_blocked_total_ns.fetch_add(ns, std::memory_order_relaxed);
+    if (ns > stat_blocked_max_ns.load(std::memory_order_relaxed)) {
+        stat_blocked_max_ns.store(ns, std::memory_order_relaxed);
+    }
+}
+
+SendBlockStats Sender::get_block_stats() const noexcept {
+    return {
+        .full = stat_full.load(std::memory_order_relaxed),
+        .spun = stat_spun.load(std::memory_order_relaxed),
+        .timeouts = stat_timeouts.load(std::memory_order_relaxed),
+        .blocked_total_ns =
+            stat_blocked_total_ns.load(std::memory_order_relaxed),
+        .blocked_max_ns = stat_blocked_max_ns.load(std::memory_order_relaxed),
+    };
+}
 } // namespace HyCAN
@@ -4,6 +4,7 @@
 #include <fcntl.h>
 #include <format>
 #include <linux/can.h>
+#include <linux/can/raw.h>
 #include <net/if.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
@@ -28,6 +29,59 @@ tl::expected<void, Error> Socket::ensure_connected() noexcept {
             Error{ErrorCode::CANSocketCreateError,
                   format("Failed to create CAN socket: {}", strerror(errno))});
     }
+    // Best effort: kernels or drivers without CAN FD reject the option, and
+    // the socket then keeps working with classic frames only.
+    constexpr int enable_fd = 1;
+    fd_frames = setsockopt(sock_fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable_fd,
+                           sizeof(enable_fd)) == 0;
+
+    if (filters) {
+        if (auto res = apply_filters(); !res) {
+            close(sock_fd);
+            sock_fd = -1;
+            return res;
+        }
+    }
+    if (timestamps) {
+        if (auto res = apply_timestamps(); !res) {
+            close(sock_fd);
+            sock_fd = -1;
+            return res;
+        }
+    }
+    if (overflow_reports) {
+        if (auto res = apply_overflow_reports(); !res) {
+            close(sock_fd);
+            sock_fd = -1;
+            return res;
+        }
+    }
+    if (error_mask != 0) {
+        if (auto res = apply_error_mask(); !res) {
+            close(sock_fd);
+            sock_fd = -1;
+            return res;
+        }
+    }
+    // Sized before bind(), so the queue has its size from the first frame.
+    if (receive_buffer > 0) {
+        if (auto res =
+                apply_buffer(SO_RCVBUFFORCE, SO_RCVBUF, receive_buffer);
+            !res) {
+            close(sock_fd);
+            sock_fd = -1;
+            return res;
+        }
+    }
+    if (send_buffer > 0) {
+        if (auto res = apply_buffer(SO_SNDBUFFORCE, SO_SNDBUF, send_buffer);
+            !res) {
+            close(sock_fd);
+            sock_fd = -1;
+            return res;
+        }
+    }
+
     ifreq ifr{};
     const auto name_len =
         std::min(interface_name.size(), static_cast<size_t>(IFNAMSIZ - 1));
@@ -61,14 +115,163 @@ tl::expected<void, Error> Socket::ensure_connected() noexcept {
     return {};
 }
 
+tl::expected<void, Error>
+Socket::set_filters(const std::span<const can_filter> new_filters) noexcept {
+    filters.emplace(new_filters.begin(), new_filters.end());
+    if (sock_fd <= 0) {
+        return {};
+    }
+    return apply_filters();
+}
+
+tl::expected<void, Error> Socket::apply_filters() const noexcept {
+    const auto size = static_cast<socklen_t>(filters->size() * sizeof(can_filter));
+    if (setsockopt(sock_fd, SOL_CAN_RAW, CAN_RAW_FILTER,
+                   filters->empty() ? nullptr : filters->data(), size) == -1) {
+        return unexpected(
+            Error{ErrorCode::CANFilterError,
+                  format("Failed to set CAN filter ({} entries): {}",
+                         filters->size(), strerror(errno))});
+    }
+    return {};
+}
+
+tl::expected<void, Error> Socket::set_timestamps(const bool enable) noexcept {
+    timestamps = enable;
+    if (sock_fd <= 0) {
+        return {};
+    }
+    return apply_timestamps();
+}
+
+tl::expected<void, Error> Socket::apply_timestamps() const noexcept {
+    const int enable = timestamps ? 1 : 0;
+    if (setsockopt(sock_fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable,
+                   sizeof(enable)) == -1) {
+        return unexpected(
+            Error{ErrorCode::CANSocketOptionError,
+                  format("Failed to set SO_TIMESTAMPNS: {}", strerror(errno))});
+    }
+    return {};
+}
+
+tl::expected<void, Error>
+Socket::set_overflow_reports(const bool enable) noexcept {
+    overflow_reports = enable;
+    if (sock_fd <= 0) {
+        return {};
+    }
+    return apply_overflow_reports();
+}
+
+tl::expected<void, Error> Socket::apply_overflow_reports() const noexcept {
+    const int enable = overflow_reports ? 1 : 0;
+    if (setsockopt(sock_fd, SOL_SOCKET, SO_RXQ_OVFL, &enable,
+                   sizeof(enable)) == -1) {
+        return unexpected(
+            Error{ErrorCode::CANSocketOptionError,
+                  format("Failed to set SO_RXQ_OVFL: {}", strerror(errno))});
+    }
+    return {};
+}
+
+tl::expected<void, Error>
+Socket::set_error_mask(const can_err_mask_t mask) noexcept {
+    error_mask = mask;
+    if (sock_fd <= 0) {
+        return {};
+    }
+    return apply_error_mask();
+}
+
+tl::expected<void, Error> Socket::apply_error_mask() const noexcept {
+    if (setsockopt(sock_fd, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &error_mask,
+                   sizeof(error_mask)) == -1) {
+        return unexpected(Error{
+            ErrorCode::CANSocketOptionError,
+            format("Failed to set CAN_RAW_ERR_FILTER: {}", strerror(errno))});
+    }
+    return {};
+}
+
+tl::expected<void, Error> Socket::set_receive_buffer(const int bytes) noexcept {
+    receive_buffer = bytes;
+    if (sock_fd <= 0 || bytes <= 0) {
+        return {};
+    }
+    return apply_buffer(SO_RCVBUFFORCE, SO_RCVBUF, bytes);
+}
+
+tl::expected<void, Error> Socket::set_send_buffer(const int bytes) noexcept {
+    send_buffer = bytes;
+    if (sock_fd <= 0 || bytes <= 0) {
+        return {};
+    }
+    return apply_buffer(SO_SNDBUFFORCE, SO_SNDBUF, bytes);
+}
+
+tl::expected<void, Error> Socket::apply_buffer(const int force_option,
+                                               const int option,
+                                               const int bytes) const noexcept {
+    if (setsockopt(sock_fd, SOL_SOCKET, force_option, &bytes, sizeof(bytes)) ==
+            0 ||
+        setsockopt(sock_fd, SOL_SOCKET, option, &bytes, sizeof(bytes)) == 0) {
+        return {};
+    }
+    return unexpected(Error{
+        ErrorCode::CANSocketOptionError,
+        format("Failed to set a {} byte socket buffer: {}", bytes,
+               strerror(errno))});
+}
+
+tl::expected<int, Error> Socket::receive_buffer_size() const noexcept {
+    return buffer_size(SO_RCVBUF);
+}
+
+tl::expected<int, Error> Socket::send_buffer_size() const noexcept {
+    return buffer_size(SO_SNDBUF);
+}
+
+tl::expected<int, Error> Socket::buffer_size(const int option) const noexcept {
+    int bytes = 0;
+    socklen_t size = sizeof(bytes);
+    if (getsockopt(sock_fd, SOL_SOCKET, option, &bytes, &size) == -1) {
+        return unexpected(
+            Error{ErrorCode::CANSocketOptionError,
+                  format("Failed to read the socket buffer size: {}",
+                         strerror(errno))});
+    }
+    return bytes;
+}
+
+tl::expected<void, Error>
+Socket::make_blocking(const std::chrono::milliseconds timeout) const noexcept {
+    const int flags = fcntl(sock_fd, F_GETFL, 0);
+    const auto seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    const timeval tv{.tv_sec = seconds.count(),
+                     .tv_usec = static_cast<suseconds_t>(
+                         std::chrono::duration_cast<std::chrono::microseconds>(
+                             timeout - seconds)
+                             .count())};
+    if (flags == -1 || fcntl(sock_fd, F_SETFL, flags & ~O_NONBLOCK) == -1 ||
+        setsockopt(sock_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == -1) {
+        return unexpected(
+            Error{ErrorCode::CANSocketOptionError,
+                  format("Failed to make socket blocking: {}",
+                         strerror(errno))});
+    }
+    return {};
+}
+
 tl::expected<void, Error> Socket::flush() const noexcept {
     if (sock_fd < 0) {
         return unexpected(Error{ErrorCode::CANInvalidSocketError,
                                 "Cannot flush with invalid socket descriptor"});
     }
-    can_frame frame{};
+    canfd_frame frame{};
     while (true) {
-        if (const ssize_t nbytes = read(sock_fd, &frame, sizeof(can_frame));
+        if (const ssize_t nbytes = read(sock_fd, &frame, sizeof(canfd_frame));
             nbytes > 0) {
         } else if (nbytes == -1 && (errno == EAGAIN || errno == EWOULDBLOCK ||
                                     errno == ENETDOWN)) {
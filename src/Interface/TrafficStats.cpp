@@ -0,0 +1,49 @@
+#include "HyCAN/Interface/TrafficStats.hpp"
+
+#include <bit>
+
+namespace HyCAN {
+TrafficStats::TrafficStats(const size_t capacity)
+    : mask(std::bit_ceil(capacity < 2 ? size_t{2} : capacity) - 1),
+      shift(32 - std::countr_zero(mask + 1)),
+      slots(std::make_unique<Slot[]>(mask + 1)) {}
+
+IdTrafficStats TrafficStats::read(const Slot &slot, const canid_t id) {
+    return {
+        .can_id = id,
+        .frames = slot.frames.load(std::memory_order_relaxed),
+        .dropped = slot.dropped.load(std::memory_order_relaxed),
+        .last_arrival = RxTimestamp(std::chrono::nanoseconds(
+            slot.last_arrival_ns.load(std::memory_order_relaxed))),
+        .mean_interval = std::chrono::nanoseconds(
+            slot.mean_interval_ns.load(std::memory_order_relaxed)),
+        .jitter = std::chrono::nanoseconds(
+            slot.jitter_ns.load(std::memory_order_relaxed)),
+    };
+}
+
+std::vector<IdTrafficStats> TrafficStats::snapshot() const {
+    std::vector<IdTrafficStats> result;
+    for (size_t pos = 0; pos <= mask; ++pos) {
+        const canid_t id = slots[pos].id.load(std::memory_order_acquire);
+        if (id != EMPTY_SLOT) {
+            result.push_back(read(slots[pos], id));
+        }
+    }
+    return result;
+}
+
+std::optional<IdTrafficStats> TrafficStats::snapshot(const canid_t key) const {
+    for (size_t i = 0, pos = probe_start(key); i <= mask && i < MAX_PROBE;
+         ++i, pos = (pos + 1) & mask) {
+        const canid_t id = slots[pos].id.load(std::memory_order_acquire);
+        if (id == key) {
+            return read(slots[pos], id);
+        }
+        if (id == EMPTY_SLOT) {
+            break;
+        }
+    }
+    return std::nullopt;
+}
+} // namespace HyCAN
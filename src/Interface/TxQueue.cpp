@@ -0,0 +1,140 @@
+#include "HyCAN/Interface/TxQueue.hpp"
+#include "HyCAN/Util/CpuRelax.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+namespace HyCAN {
+TxQueue::TxQueue(const std::string_view interface_name,
+                 const TxQueueOptions &options)
+    : options(options), ring(options.capacity), sender(interface_name) {
+    thread = std::jthread(
+        [this](const std::stop_token &stop_token) { run(stop_token); });
+}
+
+TxQueue::~TxQueue() {
+    // The thread empties the ring before it returns.
+    thread.request_stop();
+    thread.join();
+}
+
+bool TxQueue::flush(const std::chrono::nanoseconds timeout) const {
+    const uint64_t queued = ring.pushed();
+    const auto start = std::chrono::steady_clock::now();
+    while (sent.load(std::memory_order_acquire) +
+               dropped.load(std::memory_order_acquire) <
+           queued) {
+        if (std::chrono::steady_clock::now() - start >= timeout) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+TxQueueStats TxQueue::stats() const noexcept {
+    return {
+        .enqueued = ring.pushed(),
+        .rejected = rejected.load(std::memory_order_relaxed),
+        .sent = sent.load(std::memory_order_relaxed),
+        .dropped = dropped.load(std::memory_order_relaxed),
+        .full_retries = full_retries.load(std::memory_order_relaxed),
+    };
+}
+
+void TxQueue::run(const std::stop_token &stop_token) {
+    // Best effort, like a deferred worker.
+    if (options.thread.priority > 0) {
+        sched_param param{};
+        param.sched_priority = options.thread.priority;
+        (void)pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    }
+    if (options.thread.cpu_core) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(*options.thread.cpu_core, &cpu_set);
+        (void)pthread_setaffinity_np(pthread_self(), sizeof(cpu_set),
+                                     &cpu_set);
+    }
+
+    std::array<canfd_frame, Sender::MAX_BATCH_FRAMES> batch;
+    // Empty looks in a row, and the current sleep once past spinning.
+    unsigned idle = 0;
+    std::chrono::microseconds nap = options.idle_poll;
+    while (true) {
+        size_t count = 0;
+        while (count < batch.size() && ring.try_pop(batch[count])) {
+            ++count;
+        }
+        if (count > 0) {
+            send(batch.data(), count, stop_token);
+            idle = 0;
+            nap = options.idle_poll;
+            continue;
+        }
+        // Only stop once a producer that claimed a slot has filled it.
+        if (stop_token.stop_requested() && ring.popped() == ring.pushed()) {
+            return;
+        }
+        if (options.idle_poll.count() <= 0 || idle < IDLE_SPINS) {
+            Util::cpu_relax();
+        } else if (idle < IDLE_SPINS + IDLE_YIELDS) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(nap);
+            nap = std::min(nap * 2, std::max(options.max_idle_poll,
+                                             options.idle_poll));
+        }
+        if (idle < IDLE_SPINS + IDLE_YIELDS) {
+            ++idle;
+        }
+    }
+}
+
+void TxQueue::send(const canfd_frame *batch, const size_t count,
+                   const std::stop_token &stop_token) {
+    std::array<can_frame, Sender::MAX_BATCH_FRAMES> classic;
+    size_t done = 0;
+    while (done < count) {
+        // The longest run of one frame kind, sent with one send_batch.
+        const bool fd = batch[done].flags & CANFD_FDF;
+        size_t end = done + 1;
+        while (end < count && bool(batch[end].flags & CANFD_FDF) == fd) {
+            ++end;
+        }
+        BatchSendResult result;
+        if (fd) {
+            result = sender.send_batch(
+                std::span<const canfd_frame>(batch + done, end - done));
+        } else {
+            for (size_t i = done; i < end; ++i) {
+                std::memcpy(&classic[i - done], &batch[i], sizeof(can_frame));
+            }
+            result = sender.send_batch(
+                std::span<const can_frame>(classic.data(), end - done));
+        }
+        done += result.sent;
+        sent.store(sent.load(std::memory_order_relaxed) + result.sent,
+                   std::memory_order_release);
+        if (result) {
+            continue;
+        }
+        if (result.status.error().code == ErrorCode::CANSocketBufferFull &&
+            !stop_token.stop_requested()) {
+            full_retries.store(
+                full_retries.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+            std::this_thread::sleep_for(RETRY_INTERVAL);
+            continue;
+        }
+        // Skip the refused frame; the rest may still go out.
+        ++done;
+        dropped.store(dropped.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_release);
+    }
+}
+} // namespace HyCAN
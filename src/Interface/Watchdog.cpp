@@ -0,0 +1,165 @@
+#include "HyCAN/Interface/Watchdog.hpp"
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+using tl::unexpected, std::format;
+using enum HyCAN::ErrorCode;
+
+namespace HyCAN {
+Watchdog::Watchdog() {
+    // steady_clock is CLOCK_MONOTONIC.
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (timer_fd == -1) {
+        throw std::runtime_error(format(
+            "Failed to create watchdog timer fd: {}", strerror(errno)));
+    }
+}
+
+Watchdog::~Watchdog() { close(timer_fd); }
+
+Watchdog::Slot &Watchdog::slot(const canid_t key) {
+    std::lock_guard guard(mutex_);
+    return slots[key];
+}
+
+tl::expected<void, Error> Watchdog::watch(const uint64_t handle_id,
+                                          const std::span<const canid_t> keys,
+                                          const Freshness &freshness) {
+    if (freshness.deadline <= std::chrono::nanoseconds::zero()) {
+        return unexpected(
+            Error{WatchdogError, "Freshness deadline must be positive"});
+    }
+    if (!freshness.on_timeout) {
+        return unexpected(
+            Error{EmptyFuncError, "Freshness needs an on_timeout callback"});
+    }
+    std::lock_guard guard(mutex_);
+    const auto deadline = Clock::now() + freshness.deadline;
+    for (const canid_t key : keys) {
+        const uint64_t id = next_watch_id++;
+        Watch &watch =
+            watches.try_emplace(id, Watch{.id = id,
+                                          .handle_id = handle_id,
+                                          .key = key,
+                                          .slot = &slots[key],
+                                          .deadline = freshness.deadline,
+                                          .on_timeout = freshness.on_timeout,
+                                          .timer = {},
+                                          .stale_since = std::nullopt})
+                .first->second;
+        watch.timer = timers.emplace(deadline, &watch);
+    }
+    return rearm();
+}
+
+void Watchdog::unwatch(const uint64_t handle_id) {
+    remove_if([handle_id](const Watch &watch) {
+        return watch.handle_id == handle_id;
+    });
+}
+
+void Watchdog::unwatch_key(const canid_t key) {
+    remove_if([key](const Watch &watch) { return watch.key == key; });
+}
+
+void Watchdog::remove_if(const std::function<bool(const Watch &)> &pred) {
+    std::lock_guard guard(mutex_);
+    const size_t erased = std::erase_if(watches, [&](const auto &entry) {
+        if (!pred(entry.second)) {
+            return false;
+        }
+        timers.erase(entry.second.timer);
+        return true;
+    });
+    if (erased == 0) {
+        return;
+    }
+    removals.fetch_add(1, std::memory_order_release);
+    // A disarm cannot fail; a missed one only costs a spurious wakeup.
+    (void)rearm();
+}
+
+void Watchdog::expire(const Clock::time_point now) {
+    uint64_t expirations;
+    (void)read(timer_fd, &expirations, sizeof(expirations));
+    uint64_t seen_removals;
+    {
+        std::lock_guard guard(mutex_);
+        armed = Clock::time_point::max();
+        while (!timers.empty() && timers.begin()->first <= now) {
+            Watch *const watch = timers.begin()->second;
+            timers.erase(timers.begin());
+            const Clock::rep seen =
+                watch->slot->last_seen.load(std::memory_order_relaxed);
+            // The deadline the latest frame set, if it came within the
+            // window; a stale ID's first frame since also counts.
+            const auto renewed =
+                Clock::time_point(Clock::duration(seen)) + watch->deadline;
+            if (watch->stale_since != seen && renewed > now) {
+                watch->stale_since.reset();
+                watch->timer = timers.emplace(renewed, watch);
+                continue;
+            }
+            // Looked at again one deadline on, for frames resuming.
+            watch->timer = timers.emplace(now + watch->deadline, watch);
+            if (watch->stale_since == seen) {
+                continue;
+            }
+            watch->stale_since = seen;
+            timed_out.push_back({watch->id, watch->key, watch->on_timeout});
+        }
+        (void)rearm();
+        seen_removals = removals.load(std::memory_order_relaxed);
+    }
+    // Without the lock, so a callback may register or unregister; one
+    // whose watch was removed in the meantime is skipped.
+    for (auto &timeout : timed_out) {
+        if (removals.load(std::memory_order_acquire) != seen_removals) {
+            std::lock_guard guard(mutex_);
+            if (!watches.contains(timeout.watch_id)) {
+                continue;
+            }
+        }
+        timeout.on_timeout(timeout.key);
+    }
+    timed_out.clear();
+}
+
+tl::expected<void, Error> Watchdog::rearm() {
+    const auto earliest =
+        timers.empty() ? Clock::time_point::max() : timers.begin()->first;
+    next_due.store(earliest.time_since_epoch().count(),
+                   std::memory_order_relaxed);
+    if (earliest == armed) {
+        return {};
+    }
+    // A zero it_value disarms the timer.
+    itimerspec spec{};
+    if (earliest != Clock::time_point::max()) {
+        const auto since_epoch = earliest.time_since_epoch();
+        const auto seconds =
+            std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+        spec.it_value.tv_sec = seconds.count();
+        spec.it_value.tv_nsec =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch -
+                                                                 seconds)
+                .count();
+        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+            spec.it_value.tv_nsec = 1;
+        }
+    }
+    if (timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr) == -1) {
+        return unexpected(Error{
+            WatchdogError,
+            format("Failed to arm watchdog timer: {}", strerror(errno))});
+    }
+    armed = earliest;
+    return {};
+}
+} // namespace HyCAN
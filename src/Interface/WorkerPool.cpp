@@ -0,0 +1,124 @@
+#include "HyCAN/Interface/WorkerPool.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+using std::jthread;
+
+namespace HyCAN {
+WorkerPool::WorkerPool(std::span<const WorkerOptions> worker_options,
+                       const size_t queue_depth) {
+    static constexpr WorkerOptions DEFAULT_WORKER{};
+    if (worker_options.empty()) {
+        worker_options = {&DEFAULT_WORKER, 1};
+    }
+    workers.reserve(worker_options.size());
+    for (const auto &options : worker_options) {
+        auto &worker =
+            *workers.emplace_back(std::make_unique<Worker>(queue_depth));
+        worker.thread =
+            jthread([&worker, options](const std::stop_token &stop_token) {
+                run(worker, options, stop_token);
+            });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    for (const auto &worker : workers) {
+        worker->thread.request_stop();
+        worker->sleeping.store(0, std::memory_order_seq_cst);
+        worker->sleeping.notify_one();
+    }
+    // jthread joins on destruction.
+}
+
+void WorkerPool::push(const size_t worker, const FrameCallback *target,
+                      const canfd_frame &frame,
+                      const RxTimestamp timestamp) noexcept {
+    Worker &w = *workers[worker];
+    if (!w.ring.try_push({target, frame, timestamp})) {
+        w.overflows.store(w.overflows.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+        return;
+    }
+    // Pairs with the fence in run(): either the worker sees the new task
+    // before sleeping, or we see it asleep and wake it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (w.sleeping.load(std::memory_order_relaxed)) {
+        w.sleeping.store(0, std::memory_order_relaxed);
+        w.sleeping.notify_one();
+    }
+}
+
+std::vector<uint64_t> WorkerPool::marks() const {
+    std::vector<uint64_t> result;
+    result.reserve(workers.size());
+    for (const auto &worker : workers) {
+        result.push_back(worker->ring.pushed());
+    }
+    return result;
+}
+
+bool WorkerPool::passed(
+    const std::span<const uint64_t> marks) const noexcept {
+    for (size_t i = 0; i < marks.size(); ++i) {
+        // `executed` counts a task once its callback has returned.
+        if (workers[i]->executed.load(std::memory_order_acquire) < marks[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<DeferredStats> WorkerPool::stats() const {
+    std::vector<DeferredStats> result;
+    result.reserve(workers.size());
+    for (const auto &worker : workers) {
+        result.push_back({
+            .queued = worker->ring.pushed(),
+            .executed = worker->executed.load(std::memory_order_relaxed),
+            .overflows = worker->overflows.load(std::memory_order_relaxed),
+        });
+    }
+    return result;
+}
+
+void WorkerPool::run(Worker &worker, const WorkerOptions &options,
+                     const std::stop_token &stop_token) {
+    // Best effort, like the reap thread: without the privileges the worker
+    // still runs, just with default scheduling.
+    if (options.priority > 0) {
+        sched_param param{};
+        param.sched_priority = options.priority;
+        (void)pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    }
+    if (options.cpu_core) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(*options.cpu_core, &cpu_set);
+        (void)pthread_setaffinity_np(pthread_self(), sizeof(cpu_set),
+                                     &cpu_set);
+    }
+
+    Task task;
+    while (true) {
+        while (worker.ring.try_pop(task)) {
+            (*task.target)(task.frame, task.timestamp);
+            worker.executed.store(
+                worker.executed.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+        }
+        if (stop_token.stop_requested()) {
+            return;
+        }
+        worker.sleeping.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (worker.ring.pushed() != worker.ring.popped() ||
+            stop_token.stop_requested()) {
+            worker.sleeping.store(0, std::memory_order_relaxed);
+            continue;
+        }
+        worker.sleeping.wait(1, std::memory_order_acquire);
+    }
+}
+} // namespace HyCAN
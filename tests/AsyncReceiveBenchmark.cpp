@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <linux/can.h>
+
+#include "HyCAN/Interface/Dispatcher.hpp"
+#include "HyCAN/Interface/Executor.hpp"
+#include "HyCAN/Interface/IPCManager.hpp"
+#include "HyCAN/Interface/Sender.hpp"
+
+// --- Benchmark Configuration ---
+const std::string TEST_INTERFACE_NAME = "vcan_hyasync";
+constexpr canid_t REQUEST_ID = 0x601;
+constexpr canid_t REPLY_ID = 0x581;
+constexpr size_t ROUND_TRIPS = 20000;
+constexpr auto REPLY_TIMEOUT = std::chrono::milliseconds(100);
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    size_t completed = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    double cpu_us_per_trip = 0.0;
+};
+
+// CPU time of the calling thread in nanoseconds.
+uint64_t thread_cpu_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+           static_cast<uint64_t>(ts.tv_nsec);
+}
+
+Result summarize(std::vector<uint64_t> &round_trips, const uint64_t cpu_ns) {
+    Result result;
+    result.completed = round_trips.size();
+    if (round_trips.empty()) {
+        return result;
+    }
+    std::ranges::sort(round_trips);
+    result.p50_ns = round_trips[round_trips.size() / 2];
+    result.p99_ns = round_trips[round_trips.size() * 99 / 100];
+    result.cpu_us_per_trip = static_cast<double>(cpu_ns) / 1000.0 /
+                             static_cast<double>(round_trips.size());
+    return result;
+}
+
+// Today's pattern: a callback on the reap thread fills a slot and
+// notifies the requesting thread.
+Result run_callback(HyCAN::Dispatcher &client, HyCAN::Sender &sender) {
+    std::mutex mutex;
+    std::condition_variable replied;
+    std::optional<can_frame> reply;
+    (void)client
+        .register_func({REPLY_ID},
+                       [&](const can_frame &frame) {
+                           {
+                               std::lock_guard guard(mutex);
+                               reply = frame;
+                           }
+                           replied.notify_one();
+                       })
+        .or_else([](const auto &e) { std::cerr << e.message << std::endl; });
+
+    std::vector<uint64_t> round_trips;
+    round_trips.reserve(ROUND_TRIPS);
+    can_frame request{};
+    request.can_id = REQUEST_ID;
+    request.len = 8;
+    const uint64_t cpu_before = thread_cpu_ns();
+    for (size_t i = 0; i < ROUND_TRIPS; ++i) {
+        const auto start = Clock::now();
+        {
+            std::lock_guard guard(mutex);
+            reply.reset();
+        }
+        if (!sender.send(request)) {
+            continue;
+        }
+        std::unique_lock lock(mutex);
+        if (replied.wait_for(lock, REPLY_TIMEOUT,
+                             [&] { return reply.has_value(); })) {
+            round_trips.push_back(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - start)
+                    .count()));
+        }
+    }
+    const uint64_t cpu_ns = thread_cpu_ns() - cpu_before;
+    (void)client.unregister_func({REPLY_ID});
+    return summarize(round_trips, cpu_ns);
+}
+
+// The same exchange as a coroutine awaiting the reply.
+Result run_coroutine(HyCAN::Dispatcher &client, HyCAN::Sender &sender) {
+    std::vector<uint64_t> round_trips;
+    round_trips.reserve(ROUND_TRIPS);
+    const auto exchange = [&]() -> HyCAN::Task<void> {
+        can_frame request{};
+        request.can_id = REQUEST_ID;
+        request.len = 8;
+        for (size_t i = 0; i < ROUND_TRIPS; ++i) {
+            const auto start = Clock::now();
+            auto reply = client.receive(REPLY_ID, REPLY_TIMEOUT);
+            if (!co_await sender.send_async(request, REPLY_TIMEOUT)) {
+                continue;
+            }
+            if (co_await reply) {
+                round_trips.push_back(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - start)
+                        .count()));
+            }
+        }
+    };
+    HyCAN::Executor executor;
+    executor.spawn(exchange());
+    const uint64_t cpu_before = thread_cpu_ns();
+    if (auto res = executor.run(); !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+    }
+    return summarize(round_trips, thread_cpu_ns() - cpu_before);
+}
+
+void print_result(const char *label, const Result &result) {
+    std::cout << std::fixed << std::setprecision(2) << label << ": "
+              << result.completed << " round trips, p50 " << result.p50_ns
+              << " ns, p99 " << result.p99_ns << " ns, "
+              << result.cpu_us_per_trip << " us CPU/trip on the requester"
+              << std::endl;
+}
+
+int main() {
+    std::cout << "--- HyCAN Async Receive Benchmark ---" << std::endl;
+    std::cout << "INFO: Ensure 'vcan' module is loaded (sudo modprobe vcan)."
+              << std::endl;
+
+    auto &ipc = HyCAN::IPCManager::instance();
+    if (auto res = ipc.create_vcan(TEST_INTERFACE_NAME).and_then(
+            [&] { return ipc.set(TEST_INTERFACE_NAME, true); });
+        !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The device under test: answers every request at once.
+    HyCAN::Dispatcher device(TEST_INTERFACE_NAME);
+    HyCAN::Sender device_sender(TEST_INTERFACE_NAME);
+    (void)device
+        .register_func({REQUEST_ID},
+                       [&](can_frame frame) {
+                           frame.can_id = REPLY_ID;
+                           (void)device_sender.send(frame);
+                       })
+        .or_else([](const auto &e) { std::cerr << e.message << std::endl; });
+    HyCAN::Dispatcher client(TEST_INTERFACE_NAME);
+    HyCAN::Sender sender(TEST_INTERFACE_NAME);
+    if (auto res = device.start().and_then([&] { return client.start(); });
+        !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const Result callback = run_callback(client, sender);
+    const Result coroutine = run_coroutine(client, sender);
+    print_result("callback + condition_variable", callback);
+    print_result("co_await receive()           ", coroutine);
+
+    (void)client.stop();
+    (void)device.stop();
+    (void)ipc.set(TEST_INTERFACE_NAME, false);
+    std::cout << "\n--- HyCAN Async Receive Benchmark Finished ---"
+              << std::endl;
+    if (callback.completed < ROUND_TRIPS * 99 / 100 ||
+        coroutine.completed < ROUND_TRIPS * 99 / 100) {
+        std::cerr << "FAIL: Too many round trips timed out." << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <span>
+#include <string>
+#include <thread>
+
+#include <linux/can.h>
+
+#include "HyCAN/Interface/Dispatcher.hpp"
+#include "HyCAN/Interface/IPCManager.hpp"
+#include "HyCAN/Interface/Sender.hpp"
+
+// --- Benchmark Configuration ---
+const std::string TEST_INTERFACE_NAME = "vcan_hybatch";
+// One control cycle: a command frame per motor, as the stress test sends
+// them one at a time.
+constexpr size_t CYCLE_FRAMES = 16;
+constexpr canid_t BASE_CAN_ID = 0x200;
+constexpr size_t NUM_CYCLES = 50000;
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double ns_per_cycle = 0.0;
+    double frames_per_second = 0.0;
+    uint64_t full_retries = 0;
+};
+
+std::atomic<uint64_t> g_received{0};
+
+// A full queue is retried after a yield, so both variants push every frame.
+Result run_single(HyCAN::Sender &sender,
+                  const std::array<can_frame, CYCLE_FRAMES> &cycle) {
+    Result result;
+    const auto start = Clock::now();
+    for (size_t c = 0; c < NUM_CYCLES; ++c) {
+        for (const auto &frame : cycle) {
+            while (!sender.send(frame)) {
+                ++result.full_retries;
+                std::this_thread::yield();
+            }
+        }
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+        Clock::now() - start;
+    result.ns_per_cycle = elapsed.count() / NUM_CYCLES;
+    result.frames_per_second =
+        NUM_CYCLES * CYCLE_FRAMES * 1e9 / elapsed.count();
+    return result;
+}
+
+Result run_batch(HyCAN::Sender &sender,
+                 const std::array<can_frame, CYCLE_FRAMES> &cycle) {
+    Result result;
+    const auto start = Clock::now();
+    for (size_t c = 0; c < NUM_CYCLES; ++c) {
+        std::span<const can_frame> pending(cycle);
+        while (!pending.empty()) {
+            const auto sent = sender.send_batch(pending);
+            pending = pending.subspan(sent.sent);
+            if (!sent) {
+                ++result.full_retries;
+                std::this_thread::yield();
+            }
+        }
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+        Clock::now() - start;
+    result.ns_per_cycle = elapsed.count() / NUM_CYCLES;
+    result.frames_per_second =
+        NUM_CYCLES * CYCLE_FRAMES * 1e9 / elapsed.count();
+    return result;
+}
+
+void print_result(const char *label, const Result &result) {
+    std::cout << std::fixed << std::setprecision(2) << label << ": "
+              << result.ns_per_cycle << " ns/cycle, "
+              << result.frames_per_second / 1e6 << " M frames/s, "
+              << result.full_retries << " full-queue retries" << std::endl;
+}
+
+int main() {
+    std::cout << "--- HyCAN Batch Send Benchmark ---" << std::endl;
+    std::cout << "INFO: Ensure 'vcan' module is loaded (sudo modprobe vcan)."
+              << std::endl;
+    std::cout << "Config: " << NUM_CYCLES << " cycles of " << CYCLE_FRAMES
+              << " frames." << std::endl;
+
+    auto &ipc = HyCAN::IPCManager::instance();
+    if (auto res = ipc.create_vcan(TEST_INTERFACE_NAME).and_then(
+            [&] { return ipc.set(TEST_INTERFACE_NAME, true); });
+        !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::array<can_frame, CYCLE_FRAMES> cycle{};
+    std::set<size_t> ids;
+    for (size_t i = 0; i < CYCLE_FRAMES; ++i) {
+        cycle[i].can_id = BASE_CAN_ID + static_cast<canid_t>(i);
+        cycle[i].len = 8;
+        cycle[i].data[0] = static_cast<__u8>(i);
+        ids.insert(cycle[i].can_id);
+    }
+
+    // Counts what arrives, to show the batch loses nothing on the bus.
+    HyCAN::DispatcherOptions options;
+    options.receive_buffer = 8 << 20;
+    HyCAN::Dispatcher receiver(TEST_INTERFACE_NAME, std::nullopt, options);
+    (void)receiver
+        .register_func(ids,
+                       [](const can_frame &) {
+                           g_received.fetch_add(1, std::memory_order_relaxed);
+                       })
+        .or_else([](const auto &e) { std::cerr << e.message << std::endl; });
+    if (auto res = receiver.start(); !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    HyCAN::Sender sender(TEST_INTERFACE_NAME);
+    const Result single = run_single(sender, cycle);
+    const Result batch = run_batch(sender, cycle);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    print_result("send() per frame      ", single);
+    print_result("send_batch() per cycle", batch);
+    std::cout << "Speedup: " << single.ns_per_cycle / batch.ns_per_cycle
+              << "x" << std::endl;
+    const uint64_t received = g_received.load();
+    const uint64_t dropped = receiver.get_receive_stats().kernel_drops;
+    std::cout << "Received " << received << " of "
+              << 2 * NUM_CYCLES * CYCLE_FRAMES << " frames (" << dropped
+              << " dropped by the receiver's socket)." << std::endl;
+
+    (void)receiver.stop();
+    (void)ipc.set(TEST_INTERFACE_NAME, false);
+    std::cout << "\n--- HyCAN Batch Send Benchmark Finished ---" << std::endl;
+    if (received + dropped != 2 * NUM_CYCLES * CYCLE_FRAMES) {
+        std::cerr << "FAIL: Frames were lost between sender and receiver."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
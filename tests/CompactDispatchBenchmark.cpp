@@ -0,0 +1,346 @@
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <linux/can.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "HyCAN/Interface/DispatchTable.hpp"
+#include "HyCAN/Util/InlineFunction.hpp"
+
+// --- Benchmark Configuration ---
+constexpr size_t NUM_INTERFACES = 16;
+// Per interface: clusters of consecutive IDs, like motor feedback blocks.
+constexpr size_t CLUSTERS_PER_INTERFACE = 4;
+constexpr size_t IDS_PER_CLUSTER = 8;
+constexpr size_t NUM_DISPATCHES = 20000000;
+constexpr size_t TRACE_LENGTH = 1 << 16;
+// Second pass: the application sweeps this much of its own memory between
+// frames, so tables compete with it for cache.
+constexpr size_t APP_WORKING_SET_BYTES = 512 * 1024;
+constexpr size_t NUM_COLD_DISPATCHES = 20000;
+
+uint64_t g_sink = 0;
+
+struct MotorState {
+    double angle = 0.0;
+    double speed = 0.0;
+    uint64_t updates = 0;
+};
+
+// A typical user callback: a few captures, more than std::function stores
+// without allocating.
+struct UserCallback {
+    MotorState *state;
+    double scale;
+    double offset;
+
+    void operator()(const can_frame &frame) const {
+        state->angle = frame.data[0] * scale + offset;
+        state->speed = frame.data[1];
+        ++state->updates;
+    }
+};
+
+// What Dispatcher::register_func wraps around a classic-frame callback.
+auto make_wrapper(const UserCallback &user) {
+    return [func = user](const canfd_frame &frame) {
+        if (frame.flags & CANFD_FDF) {
+            return;
+        }
+        can_frame classic;
+        std::memcpy(&classic, &frame, sizeof(classic));
+        func(classic);
+    };
+}
+
+// Pre-change layout: a std::function slot for every possible standard ID.
+using LegacyTable =
+    std::array<std::function<void(const canfd_frame &)>, CAN_SFF_MASK + 1>;
+
+// Current layout: dense table of inline callables.
+using CompactCallback = HyCAN::Util::InlineFunction<void(const canfd_frame &)>;
+using CompactTable = HyCAN::DispatchTable<CompactCallback>;
+
+struct Event {
+    uint32_t interface;
+    canid_t can_id;
+};
+
+// Hardware counters, when the kernel lets us open them.
+class PerfCounter {
+  public:
+    PerfCounter(const uint32_t type, const uint64_t config) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(
+            syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    ~PerfCounter() {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+    PerfCounter(const PerfCounter &) = delete;
+    PerfCounter &operator=(const PerfCounter &) = delete;
+
+    void start() const {
+        if (fd != -1) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    void pause() const {
+        if (fd != -1) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    void resume() const {
+        if (fd != -1) {
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    [[nodiscard]] std::optional<uint64_t> stop() const {
+        if (fd == -1) {
+            return std::nullopt;
+        }
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t count = 0;
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+            return std::nullopt;
+        }
+        return count;
+    }
+
+  private:
+    int fd{-1};
+};
+
+struct Result {
+    double ns_per_dispatch = 0.0;
+    std::optional<uint64_t> cache_misses;
+    std::optional<uint64_t> l1d_misses;
+    size_t iterations = 0;
+};
+
+// Streams through `bytes` of unrelated memory, standing in for the rest of
+// the application touching its own data between frames.
+uint64_t touch_working_set(std::vector<uint64_t> &working_set,
+                           const size_t bytes) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < bytes / sizeof(uint64_t); i += 8) {
+        sum += ++working_set[i];
+    }
+    return sum;
+}
+
+template <typename Dispatch>
+Result measure(const std::vector<Event> &trace, const size_t app_bytes,
+               Dispatch &&dispatch) {
+    const PerfCounter cache_misses(PERF_TYPE_HARDWARE,
+                                   PERF_COUNT_HW_CACHE_MISSES);
+    const PerfCounter l1d_misses(
+        PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    std::vector<uint64_t> working_set(app_bytes / sizeof(uint64_t) + 8);
+    const size_t iterations =
+        app_bytes == 0 ? NUM_DISPATCHES : NUM_COLD_DISPATCHES;
+    // Warm up once so both layouts start from the same cache state.
+    for (const auto &event : trace) {
+        dispatch(event);
+    }
+    Result result;
+    result.iterations = iterations;
+    if (app_bytes == 0) {
+        cache_misses.start();
+        l1d_misses.start();
+        const auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            dispatch(trace[i & (TRACE_LENGTH - 1)]);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        result.cache_misses = cache_misses.stop();
+        result.l1d_misses = l1d_misses.stop();
+        result.ns_per_dispatch =
+            static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end -
+                                                                     begin)
+                    .count()) /
+            static_cast<double>(iterations);
+        return result;
+    }
+
+    // Cold pass: time and count each dispatch on its own, after the sweep,
+    // and subtract the cost of an empty timed section.
+    const auto timed = [&](const auto &body) {
+        int64_t total_ns = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            g_sink += touch_working_set(working_set, app_bytes);
+            cache_misses.resume();
+            l1d_misses.resume();
+            const auto begin = std::chrono::steady_clock::now();
+            body(trace[i & (TRACE_LENGTH - 1)]);
+            const auto end = std::chrono::steady_clock::now();
+            cache_misses.pause();
+            l1d_misses.pause();
+            total_ns +=
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end -
+                                                                     begin)
+                    .count();
+        }
+        return total_ns;
+    };
+    cache_misses.start();
+    l1d_misses.start();
+    cache_misses.pause();
+    l1d_misses.pause();
+    const int64_t overhead_ns = timed([](const Event &) {});
+    const auto overhead_cache = cache_misses.stop();
+    const auto overhead_l1d = l1d_misses.stop();
+    cache_misses.start();
+    l1d_misses.start();
+    cache_misses.pause();
+    l1d_misses.pause();
+    const int64_t dispatch_ns = timed(dispatch);
+    const auto minus = [](const std::optional<uint64_t> &count,
+                          const std::optional<uint64_t> &overhead)
+        -> std::optional<uint64_t> {
+        if (!count || !overhead) {
+            return std::nullopt;
+        }
+        return *count > *overhead ? *count - *overhead : 0;
+    };
+    result.cache_misses = minus(cache_misses.stop(), overhead_cache);
+    result.l1d_misses = minus(l1d_misses.stop(), overhead_l1d);
+    result.ns_per_dispatch = static_cast<double>(dispatch_ns - overhead_ns) /
+                             static_cast<double>(iterations);
+    return result;
+}
+
+void print_result(const char *label, const Result &result) {
+    const auto per_k = [&](const std::optional<uint64_t> &count) {
+        if (!count) {
+            return std::string("n/a");
+        }
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2)
+            << static_cast<double>(*count) * 1000.0 /
+                   static_cast<double>(result.iterations);
+        return out.str();
+    };
+    std::cout << std::fixed << std::setprecision(2) << label << ": "
+              << result.ns_per_dispatch << " ns/dispatch, "
+              << per_k(result.cache_misses) << " LLC misses/1k, "
+              << per_k(result.l1d_misses) << " L1D misses/1k" << std::endl;
+}
+
+int main() {
+    std::cout << "--- HyCAN Compact Dispatch Benchmark ---" << std::endl;
+    std::cout << "Config: " << NUM_INTERFACES << " interfaces x "
+              << CLUSTERS_PER_INTERFACE * IDS_PER_CLUSTER
+              << " registered IDs, " << NUM_DISPATCHES << " dispatches."
+              << std::endl;
+
+    std::mt19937 rng(42);
+    std::vector<MotorState> states(NUM_INTERFACES * CLUSTERS_PER_INTERFACE *
+                                   IDS_PER_CLUSTER);
+    std::vector<std::unique_ptr<LegacyTable>> legacy;
+    std::vector<std::unique_ptr<CompactTable>> compact;
+    std::vector<std::vector<canid_t>> registered(NUM_INTERFACES);
+    size_t state_index = 0;
+    for (size_t iface = 0; iface < NUM_INTERFACES; ++iface) {
+        legacy.push_back(std::make_unique<LegacyTable>());
+        compact.push_back(std::make_unique<CompactTable>());
+        std::uniform_int_distribution<canid_t> base(
+            0, (CAN_SFF_MASK + 1) / IDS_PER_CLUSTER - 1);
+        for (size_t c = 0; c < CLUSTERS_PER_INTERFACE; ++c) {
+            const canid_t first = base(rng) * IDS_PER_CLUSTER;
+            for (canid_t id = first; id < first + IDS_PER_CLUSTER; ++id) {
+                if ((*legacy[iface])[id]) {
+                    continue;
+                }
+                const UserCallback user{&states[state_index++], 0.5, 1.0};
+                (*legacy[iface])[id] = make_wrapper(user);
+                (*compact[iface])[id] = make_wrapper(user);
+                registered[iface].push_back(id);
+            }
+        }
+    }
+
+    std::vector<Event> trace(TRACE_LENGTH);
+    std::uniform_int_distribution<uint32_t> pick_iface(0, NUM_INTERFACES - 1);
+    for (auto &event : trace) {
+        event.interface = pick_iface(rng);
+        const auto &ids = registered[event.interface];
+        event.can_id = ids[rng() % ids.size()];
+    }
+
+    canfd_frame frame{};
+    frame.len = 8;
+    frame.data[0] = 10;
+    const auto legacy_dispatch = [&](const Event &event) {
+        frame.can_id = event.can_id;
+        if (auto &func = (*legacy[event.interface])[event.can_id]) {
+            func(frame);
+        }
+    };
+    const auto compact_dispatch = [&](const Event &event) {
+        frame.can_id = event.can_id;
+        if (auto *func = compact[event.interface]->find(event.can_id)) {
+            (*func)(frame);
+        }
+    };
+
+    std::cout << "\nHot loop:" << std::endl;
+    print_result("std::function[2048] per interface",
+                 measure(trace, 0, legacy_dispatch));
+    print_result("DispatchTable<InlineFunction>    ",
+                 measure(trace, 0, compact_dispatch));
+    std::cout << "\nWith a " << APP_WORKING_SET_BYTES / 1024
+              << " KB application sweep between frames:" << std::endl;
+    print_result("std::function[2048] per interface",
+                 measure(trace, APP_WORKING_SET_BYTES, legacy_dispatch));
+    print_result("DispatchTable<InlineFunction>    ",
+                 measure(trace, APP_WORKING_SET_BYTES, compact_dispatch));
+
+    std::cout << "\nTable footprint per interface: "
+              << sizeof(LegacyTable) / 1024 << " KB + heap-boxed targets vs "
+              << (sizeof(CompactTable) +
+                  (compact[0]->size() + 1) * sizeof(CompactCallback)) /
+                     1024
+              << " KB." << std::endl;
+    std::cout << "(sink " << g_sink << ")" << std::endl;
+
+    uint64_t updates = 0;
+    for (const auto &state : states) {
+        updates += state.updates;
+    }
+    const uint64_t expected =
+        2 * (NUM_DISPATCHES + NUM_COLD_DISPATCHES + 2 * TRACE_LENGTH);
+    std::cout << "\n--- HyCAN Compact Dispatch Benchmark Finished ---"
+              << std::endl;
+    if (updates != expected) {
+        std::cerr << "FAIL: " << updates << " callback calls, expected "
+                  << expected << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
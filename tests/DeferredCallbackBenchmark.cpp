@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <linux/can.h>
+
+#include "HyCAN/Interface/Dispatcher.hpp"
+#include "HyCAN/Interface/IPCManager.hpp"
+#include "HyCAN/Interface/Sender.hpp"
+
+// --- Benchmark Configuration ---
+const std::string TEST_INTERFACE_NAME = "vcan_hydefer";
+// A control-loop ID whose latency we care about.
+constexpr canid_t FAST_CAN_ID = 0x101;
+// A logging-style ID whose callback is slow.
+constexpr canid_t SLOW_CAN_ID = 0x102;
+constexpr auto SLOW_CALLBACK_TIME = std::chrono::microseconds(200);
+constexpr uint64_t FRAMES_PER_RUN = 5000;
+// Both IDs are sent every interval, the slow one first.
+constexpr auto SEND_INTERVAL = std::chrono::microseconds(500);
+constexpr auto DRAIN_TIMEOUT = std::chrono::seconds(3);
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<uint64_t> g_fast_received{0};
+std::atomic<uint64_t> g_slow_received{0};
+std::vector<uint64_t> g_latencies_ns;
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch())
+            .count());
+}
+
+struct RunResult {
+    uint64_t fast_received = 0;
+    uint64_t slow_received = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t overflows = 0;
+};
+
+RunResult run(const HyCAN::Delivery slow_delivery) {
+    RunResult result;
+    g_fast_received.store(0, std::memory_order_relaxed);
+    g_slow_received.store(0, std::memory_order_relaxed);
+    g_latencies_ns.assign(FRAMES_PER_RUN, 0);
+
+    HyCAN::Dispatcher dispatcher(TEST_INTERFACE_NAME);
+    auto registered =
+        dispatcher
+            .register_func({FAST_CAN_ID},
+                           [](const can_frame &frame) {
+                               const uint64_t received_at = now_ns();
+                               uint64_t sent_at;
+                               std::memcpy(&sent_at, frame.data,
+                                           sizeof(sent_at));
+                               const uint64_t n = g_fast_received.fetch_add(
+                                   1, std::memory_order_relaxed);
+                               if (n < g_latencies_ns.size()) {
+                                   g_latencies_ns[n] = received_at - sent_at;
+                               }
+                           })
+            .and_then([&](HyCAN::CallbackHandle) {
+                return dispatcher.register_func(
+                    {SLOW_CAN_ID},
+                    [](const can_frame &) {
+                        // Busy work, as a logger or controller step would.
+                        const auto until = Clock::now() + SLOW_CALLBACK_TIME;
+                        while (Clock::now() < until) {
+                        }
+                        g_slow_received.fetch_add(1,
+                                                  std::memory_order_relaxed);
+                    },
+                    slow_delivery);
+            })
+            .and_then([&](HyCAN::CallbackHandle) { return dispatcher.start(); });
+    if (!registered) {
+        std::cerr << "FAIL: " << registered.error().message << std::endl;
+        return result;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    HyCAN::Sender sender(TEST_INTERFACE_NAME);
+    can_frame slow_frame{};
+    slow_frame.can_id = SLOW_CAN_ID;
+    slow_frame.len = 8;
+    can_frame fast_frame{};
+    fast_frame.can_id = FAST_CAN_ID;
+    fast_frame.len = 8;
+
+    auto next_send = Clock::now();
+    for (uint64_t sent = 0; sent < FRAMES_PER_RUN; ++sent) {
+        while (Clock::now() < next_send) {
+        }
+        (void)sender.send(slow_frame);
+        const uint64_t sent_at = now_ns();
+        std::memcpy(fast_frame.data, &sent_at, sizeof(sent_at));
+        (void)sender.send(fast_frame);
+        next_send += SEND_INTERVAL;
+    }
+
+    const auto deadline = Clock::now() + DRAIN_TIMEOUT;
+    while ((g_fast_received.load(std::memory_order_relaxed) < FRAMES_PER_RUN ||
+            g_slow_received.load(std::memory_order_relaxed) < FRAMES_PER_RUN) &&
+           Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    (void)dispatcher.stop();
+
+    result.fast_received = std::min<uint64_t>(
+        g_fast_received.load(std::memory_order_relaxed), FRAMES_PER_RUN);
+    result.slow_received = g_slow_received.load(std::memory_order_relaxed);
+    for (const auto &stats : dispatcher.get_deferred_stats()) {
+        result.overflows += stats.overflows;
+    }
+    if (result.fast_received > 0) {
+        auto latencies = g_latencies_ns;
+        latencies.resize(result.fast_received);
+        std::sort(latencies.begin(), latencies.end());
+        result.p50_ns = latencies[latencies.size() / 2];
+        result.p99_ns = latencies[latencies.size() * 99 / 100];
+        result.max_ns = latencies.back();
+    }
+    return result;
+}
+
+int main() {
+    std::cout << "--- HyCAN Deferred Callback Benchmark ---" << std::endl;
+    std::cout << "INFO: Ensure 'vcan' module is loaded (sudo modprobe vcan)."
+              << std::endl;
+
+    auto &ipc = HyCAN::IPCManager::instance();
+    if (auto res = ipc.create_vcan(TEST_INTERFACE_NAME).and_then(
+            [&] { return ipc.set(TEST_INTERFACE_NAME, true); });
+        !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int result_code = EXIT_SUCCESS;
+    std::cout << "Fast ID latency while the slow ID's callback takes "
+              << SLOW_CALLBACK_TIME.count() << " us:" << std::endl;
+    std::cout << std::setw(12) << "slow mode" << std::setw(10) << "fast"
+              << std::setw(10) << "slow" << std::setw(12) << "p50 ns"
+              << std::setw(12) << "p99 ns" << std::setw(12) << "max ns"
+              << std::setw(12) << "overflows" << std::endl;
+    for (const auto delivery :
+         {HyCAN::Delivery::Inline, HyCAN::Delivery::Deferred}) {
+        const RunResult r = run(delivery);
+        const char *name =
+            delivery == HyCAN::Delivery::Inline ? "inline" : "deferred";
+        if (r.fast_received == 0) {
+            std::cerr << "FAIL: no fast frames received with " << name
+                      << " slow callback" << std::endl;
+            result_code = EXIT_FAILURE;
+            continue;
+        }
+        std::cout << std::setw(12) << name << std::setw(10)
+                  << r.fast_received << std::setw(10) << r.slow_received
+                  << std::setw(12) << r.p50_ns << std::setw(12) << r.p99_ns
+                  << std::setw(12) << r.max_ns << std::setw(12)
+                  << r.overflows << std::endl;
+    }
+
+    (void)ipc.set(TEST_INTERFACE_NAME, false);
+    std::cout << "\n--- HyCAN Deferred Callback Benchmark Finished ---"
+              << std::endl;
+    return result_code;
+}
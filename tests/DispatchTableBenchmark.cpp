@@ -0,0 +1,92 @@
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <linux/can.h>
+
+#include "HyCAN/Interface/DispatchTable.hpp"
+
+// --- Benchmark Configuration ---
+constexpr size_t NUM_REGISTERED_IDS = 64;
+constexpr size_t NUM_LOOKUPS = 20000000;
+constexpr canid_t STD_BASE_ID = 0x200;
+constexpr canid_t EXT_BASE_ID = 0x18FF0000; // J1939-style PGN block
+
+using Callback = std::function<void(can_frame)>;
+
+uint64_t g_sink = 0;
+
+template <typename Lookup>
+double measure_ns_per_lookup(const std::vector<canid_t> &trace,
+                             Lookup &&lookup) {
+    uint64_t hits = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NUM_LOOKUPS; ++i) {
+        hits += lookup(trace[i & (trace.size() - 1)]);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    g_sink += hits;
+    if (hits != NUM_LOOKUPS) {
+        std::cerr << "FAIL: only " << hits << " of " << NUM_LOOKUPS
+                  << " lookups hit a registered callback." << std::endl;
+        return -1.0;
+    }
+    return static_cast<double>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+                   .count()) /
+           static_cast<double>(NUM_LOOKUPS);
+}
+
+int main() {
+    std::cout << "--- HyCAN Dispatch Table Benchmark ---" << std::endl;
+    std::cout << "Config: " << NUM_REGISTERED_IDS << " registered IDs, "
+              << NUM_LOOKUPS << " lookups per case." << std::endl;
+
+    const Callback callback = [](can_frame frame) { g_sink += frame.len; };
+
+    // Today's layout: a direct std::function array indexed by can_id.
+    static Callback direct_array[CAN_SFF_MASK + 1]{};
+    auto table = std::make_unique<HyCAN::DispatchTable<Callback>>();
+    for (size_t i = 0; i < NUM_REGISTERED_IDS; ++i) {
+        direct_array[STD_BASE_ID + i] = callback;
+        (*table)[STD_BASE_ID + i] = callback;
+        (*table)[(EXT_BASE_ID + i * 0x100) | CAN_EFF_FLAG] = callback;
+    }
+
+    // Random traffic over the registered IDs; power-of-two length so the
+    // loop index is a mask.
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, NUM_REGISTERED_IDS - 1);
+    std::vector<canid_t> std_trace(1 << 16), ext_trace(1 << 16);
+    for (size_t i = 0; i < std_trace.size(); ++i) {
+        const size_t n = pick(rng);
+        std_trace[i] = STD_BASE_ID + n;
+        ext_trace[i] = (EXT_BASE_ID + n * 0x100) | CAN_EFF_FLAG;
+    }
+
+    const double direct_ns = measure_ns_per_lookup(
+        std_trace, [&](const canid_t id) { return !!direct_array[id]; });
+    const double std_ns = measure_ns_per_lookup(
+        std_trace, [&](const canid_t id) { return table->find(id) != nullptr; });
+    const double ext_ns = measure_ns_per_lookup(
+        ext_trace, [&](const canid_t id) { return table->find(id) != nullptr; });
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "std::function[2048] (standard IDs): " << direct_ns
+              << " ns/lookup" << std::endl;
+    std::cout << "DispatchTable       (standard IDs): " << std_ns
+              << " ns/lookup" << std::endl;
+    std::cout << "DispatchTable       (extended IDs): " << ext_ns
+              << " ns/lookup" << std::endl;
+    std::cout << "(sink " << g_sink << ")" << std::endl;
+
+    std::cout << "\n--- HyCAN Dispatch Table Benchmark Finished ---"
+              << std::endl;
+    return direct_ns < 0 || std_ns < 0 || ext_ns < 0 ? EXIT_FAILURE
+                                                     : EXIT_SUCCESS;
+}
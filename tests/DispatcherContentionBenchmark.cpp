@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <linux/can.h>
+
+#include "HyCAN/Interface/Dispatcher.hpp"
+#include "HyCAN/Interface/IPCManager.hpp"
+#include "HyCAN/Interface/Sender.hpp"
+
+// --- Benchmark Configuration ---
+const std::string TEST_INTERFACE_NAME = "vcan_hycontend";
+constexpr canid_t TRAFFIC_CAN_ID = 0x100;
+constexpr canid_t CHURN_BASE_ID = 0x300;
+constexpr size_t CHURN_ID_COUNT = 32;
+constexpr auto SEND_PERIOD = std::chrono::microseconds(100); // 10 kHz
+constexpr auto PHASE_DURATION = std::chrono::seconds(3);
+constexpr size_t MAX_SAMPLES = 64 * 1024;
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               Clock::now().time_since_epoch())
+        .count();
+}
+
+// Latency samples per phase: 0 = no registrations, 1 = registration churn.
+struct PhaseSamples {
+    std::vector<uint64_t> latency_ns = std::vector<uint64_t>(MAX_SAMPLES);
+    std::atomic<size_t> count{0};
+};
+std::array<PhaseSamples, 2> g_samples;
+std::atomic<int> g_phase{0};
+
+void print_summary(const std::string &label, std::vector<uint64_t> values) {
+    if (values.empty()) {
+        std::cout << label << ": no samples" << std::endl;
+        return;
+    }
+    std::ranges::sort(values);
+    uint64_t sum = 0;
+    for (const auto v : values)
+        sum += v;
+    const auto pct = [&](const double p) {
+        return values[std::min(values.size() - 1,
+                               static_cast<size_t>(p * values.size()))];
+    };
+    std::cout << std::fixed << std::setprecision(2) << label << ": n="
+              << values.size() << " avg=" << sum / values.size() / 1000.0
+              << "us p50=" << pct(0.50) / 1000.0
+              << "us p99=" << pct(0.99) / 1000.0
+              << "us max=" << values.back() / 1000.0 << "us" << std::endl;
+}
+
+int main() {
+    std::cout << "--- HyCAN Dispatcher Contention Benchmark ---" << std::endl;
+    std::cout << "INFO: Ensure 'vcan' module is loaded (sudo modprobe vcan)."
+              << std::endl;
+
+    auto &ipc = HyCAN::IPCManager::instance();
+    if (auto res = ipc.create_vcan(TEST_INTERFACE_NAME).and_then(
+            [&] { return ipc.set(TEST_INTERFACE_NAME, true); });
+        !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    HyCAN::Dispatcher dispatcher(TEST_INTERFACE_NAME);
+    (void)dispatcher
+        .register_func({TRAFFIC_CAN_ID},
+                       [](const can_frame &frame) {
+                           uint64_t sent_ns;
+                           std::memcpy(&sent_ns, frame.data, sizeof(sent_ns));
+                           auto &phase = g_samples[g_phase.load(
+                               std::memory_order_relaxed)];
+                           const size_t i = phase.count.fetch_add(
+                               1, std::memory_order_relaxed);
+                           if (i < MAX_SAMPLES) {
+                               phase.latency_ns[i] = now_ns() - sent_ns;
+                           }
+                       })
+        .or_else([](const auto &e) { std::cerr << e.message << std::endl; });
+    if (auto res = dispatcher.start(); !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::atomic<bool> stop_traffic{false};
+    uint64_t frames_sent = 0;
+    std::jthread traffic([&] {
+        HyCAN::Sender sender(TEST_INTERFACE_NAME);
+        can_frame frame{};
+        frame.can_id = TRAFFIC_CAN_ID;
+        frame.len = 8;
+        auto next = Clock::now();
+        while (!stop_traffic.load(std::memory_order_relaxed)) {
+            next += SEND_PERIOD;
+            std::this_thread::sleep_until(next);
+            const uint64_t sent_ns = now_ns();
+            std::memcpy(frame.data, &sent_ns, sizeof(sent_ns));
+            if (sender.send(frame)) {
+                ++frames_sent;
+            }
+        }
+    });
+
+    std::cout << "\nPhase 1: 10 kHz traffic, no registrations ("
+              << PHASE_DURATION.count() << "s)..." << std::endl;
+    std::this_thread::sleep_for(PHASE_DURATION);
+
+    std::cout << "Phase 2: 10 kHz traffic while registering callbacks ("
+              << PHASE_DURATION.count() << "s)..." << std::endl;
+    g_phase.store(1, std::memory_order_relaxed);
+    std::vector<uint64_t> register_ns;
+    const auto churn_end = Clock::now() + PHASE_DURATION;
+    for (size_t n = 0; Clock::now() < churn_end; ++n) {
+        const size_t id = CHURN_BASE_ID + n % CHURN_ID_COUNT;
+        const uint64_t begin = now_ns();
+        auto res = n / CHURN_ID_COUNT % 2 == 0
+                       ? dispatcher.register_func({id}, [](can_frame) {})
+                             .map([](HyCAN::CallbackHandle) {})
+                       : dispatcher.unregister_func({id});
+        register_ns.push_back(now_ns() - begin);
+        if (!res) {
+            std::cerr << "FAIL: " << res.error().message << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    stop_traffic.store(true, std::memory_order_relaxed);
+    traffic.join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    (void)dispatcher.stop();
+    (void)ipc.set(TEST_INTERFACE_NAME, false);
+
+    std::cout << "\n--- Results ---" << std::endl;
+    uint64_t frames_received = 0;
+    for (size_t phase = 0; phase < g_samples.size(); ++phase) {
+        const size_t n = std::min(g_samples[phase].count.load(), MAX_SAMPLES);
+        frames_received += g_samples[phase].count.load();
+        print_summary(phase == 0 ? "Dispatch latency (idle)   "
+                                 : "Dispatch latency (churn)  ",
+                      {g_samples[phase].latency_ns.begin(),
+                       g_samples[phase].latency_ns.begin() +
+                           static_cast<std::ptrdiff_t>(n)});
+    }
+    print_summary("Register/unregister call  ", register_ns);
+    std::cout << "Frames sent: " << frames_sent
+              << ", received: " << frames_received << std::endl;
+
+    std::cout << "\n--- HyCAN Dispatcher Contention Benchmark Finished ---"
+              << std::endl;
+    if (frames_received == 0) {
+        std::cerr << "FAIL: no frames received." << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
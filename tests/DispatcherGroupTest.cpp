@@ -0,0 +1,215 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "HyCAN/Interface/DispatcherGroup.hpp"
+#include "HyCAN/Interface/Interface.hpp"
+#include <linux/can.h>
+
+// Four buses served by one shared reap thread.
+constexpr size_t BUS_COUNT = 4;
+const std::array<std::string, BUS_COUNT> BUS_NAMES = {
+    "vcan_hygrp0", "vcan_hygrp1", "vcan_hygrp2", "vcan_hygrp3"};
+// The same ID on every bus, so a demux mistake shows up as a wrong count.
+constexpr canid_t TEST_CAN_ID = 0x2A0;
+constexpr int FRAMES_PER_BUS = 1000;
+constexpr auto WAIT_TIMEOUT = std::chrono::seconds(3);
+
+struct BusState {
+    std::atomic<int> received{0};
+    std::atomic<int> foreign{0}; // frames tagged with another bus index
+    std::atomic<std::thread::id> thread{};
+};
+
+std::array<BusState, BUS_COUNT> g_buses;
+
+bool wait_for(const size_t bus, const int expected) {
+    const auto deadline = std::chrono::steady_clock::now() + WAIT_TIMEOUT;
+    while (g_buses[bus].received.load() < expected) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+void send_burst(HyCAN::VCANInterface &interface, const size_t bus) {
+    can_frame frame{};
+    frame.can_id = TEST_CAN_ID;
+    frame.len = 1;
+    frame.data[0] = static_cast<__u8>(bus);
+    for (int sent = 0; sent < FRAMES_PER_BUS;) {
+        if (interface.send(frame)) {
+            ++sent;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+int main() {
+    int result_code = EXIT_SUCCESS;
+    std::cout << "--- HyCAN Dispatcher Group Test ---" << std::endl;
+    std::cout << "INFO: Ensure 'vcan' module is loaded (sudo modprobe vcan)."
+              << std::endl;
+
+    HyCAN::DispatcherGroup group;
+    std::array<std::unique_ptr<HyCAN::VCANInterface>, BUS_COUNT> interfaces;
+    for (size_t bus = 0; bus < BUS_COUNT; ++bus) {
+        interfaces[bus] =
+            std::make_unique<HyCAN::VCANInterface>(BUS_NAMES[bus], group);
+        auto res =
+            interfaces[bus]
+                ->register_callback(
+                    {TEST_CAN_ID},
+                    [bus](const can_frame &frame) {
+                        auto &state = g_buses[bus];
+                        if (frame.data[0] != bus) {
+                            state.foreign.fetch_add(1);
+                        }
+                        state.thread.store(std::this_thread::get_id());
+                        state.received.fetch_add(1);
+                    })
+                .and_then([&](HyCAN::CallbackHandle) {
+                    return interfaces[bus]->up();
+                });
+        if (!res) {
+            std::cerr << "FAIL: " << BUS_NAMES[bus] << ": "
+                      << res.error().message << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (group.size() != BUS_COUNT) {
+        std::cerr << "FAIL: group holds " << group.size()
+                  << " dispatchers, expected " << BUS_COUNT << std::endl;
+        result_code = EXIT_FAILURE;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Test 1: every bus sees exactly its own frames, all on one thread.
+    std::cout << "\n[Test 1] Demultiplexing " << BUS_COUNT
+              << " buses on one thread..." << std::endl;
+    {
+        std::array<std::jthread, BUS_COUNT> senders;
+        for (size_t bus = 0; bus < BUS_COUNT; ++bus) {
+            senders[bus] = std::jthread(
+                [&, bus] { send_burst(*interfaces[bus], bus); });
+        }
+    }
+    for (size_t bus = 0; bus < BUS_COUNT; ++bus) {
+        if (!wait_for(bus, FRAMES_PER_BUS)) {
+            std::cerr << "FAIL: " << BUS_NAMES[bus] << " received "
+                      << g_buses[bus].received.load() << "/" << FRAMES_PER_BUS
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        }
+        if (g_buses[bus].foreign.load() != 0) {
+            std::cerr << "FAIL: " << BUS_NAMES[bus] << " saw "
+                      << g_buses[bus].foreign.load()
+                      << " frames from other buses" << std::endl;
+            result_code = EXIT_FAILURE;
+        }
+        if (g_buses[bus].thread.load() != g_buses[0].thread.load()) {
+            std::cerr << "FAIL: " << BUS_NAMES[bus]
+                      << " was served by a different thread" << std::endl;
+            result_code = EXIT_FAILURE;
+        }
+    }
+    if (result_code == EXIT_SUCCESS) {
+        std::cout << "PASS: all buses demultiplexed on a shared thread."
+                  << std::endl;
+    }
+
+    // Test 2: taking one bus down leaves the others running.
+    std::cout << "\n[Test 2] Detaching one bus..." << std::endl;
+    if (auto res = interfaces[0]->down(); !res) {
+        std::cerr << "FAIL: down: " << res.error().message << std::endl;
+        result_code = EXIT_FAILURE;
+    }
+    if (group.size() != BUS_COUNT - 1) {
+        std::cerr << "FAIL: group still holds " << group.size()
+                  << " dispatchers" << std::endl;
+        result_code = EXIT_FAILURE;
+    }
+    send_burst(*interfaces[1], 1);
+    if (!wait_for(1, 2 * FRAMES_PER_BUS)) {
+        std::cerr << "FAIL: remaining bus stopped receiving" << std::endl;
+        result_code = EXIT_FAILURE;
+    } else {
+        std::cout << "PASS: remaining buses keep receiving." << std::endl;
+    }
+
+    // Test 3: a callback starting a member while another thread detaches
+    // one; the detach waits for the callback's pass, which needs the
+    // group's lock for the attach.
+    std::cout << "\n[Test 3] Starting a bus from a callback during a "
+                 "detach..."
+              << std::endl;
+    {
+        std::atomic<bool> restarted{false};
+        std::atomic<bool> detached{false};
+        const auto restarter = interfaces[1]->register_callback(
+            {TEST_CAN_ID + 1}, [&](const can_frame &) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                restarted = static_cast<bool>(interfaces[0]->up());
+            });
+        can_frame trigger{};
+        trigger.can_id = TEST_CAN_ID + 1;
+        if (!restarter || !interfaces[1]->send(trigger)) {
+            std::cerr << "FAIL: could not trigger the restart" << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            std::thread detacher([&] {
+                (void)interfaces[2]->down();
+                detached = true;
+            });
+            const auto deadline =
+                std::chrono::steady_clock::now() + WAIT_TIMEOUT;
+            while (!detached.load() &&
+                   std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            if (!detached.load()) {
+                // The two threads are stuck on each other; nothing to join.
+                std::cerr << "FAIL: detach deadlocked with the callback"
+                          << std::endl;
+                std::_Exit(EXIT_FAILURE);
+            }
+            detacher.join();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            if (!restarted.load() || group.size() != BUS_COUNT - 1) {
+                std::cerr << "FAIL: expected the bus restarted and "
+                          << BUS_COUNT - 1 << " dispatchers, got "
+                          << group.size() << std::endl;
+                result_code = EXIT_FAILURE;
+            } else {
+                std::cout << "PASS: detach and a callback's start both "
+                             "completed."
+                          << std::endl;
+            }
+        }
+        if (restarter) {
+            (void)interfaces[1]->unregister_callback(*restarter);
+        }
+    }
+
+    for (size_t bus = 0; bus < BUS_COUNT; ++bus) {
+        (void)interfaces[bus]->down();
+    }
+    interfaces = {};
+    if (group.size() != 0) {
+        std::cerr << "FAIL: dispatchers left attached after destruction"
+                  << std::endl;
+        result_code = EXIT_FAILURE;
+    }
+
+    std::cout << "\n--- HyCAN Dispatcher Group Test Finished ---" << std::endl;
+    return result_code;
+}
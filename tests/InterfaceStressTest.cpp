@@ -71,19 +71,9 @@ void sender_worker_fn(const int thread_id, const canid_t base_can_id) {
     while (!g_stop_sending_flag.load(std::memory_order_acquire)) {
         frame_to_send.can_id = base_can_id + interface_rr_index;
 
-#ifdef HYCAN_LATENCY_TEST
-        auto send_time = std::chrono::high_resolution_clock::now();
-        uint64_t send_timestamp_ns_count =
-            std::chrono::duration_cast<std::chrono::nanoseconds>(
-                send_time.time_since_epoch())
-                .count();
-        std::memcpy(frame_to_send.data, &send_timestamp_ns_count,
-                    sizeof(send_timestamp_ns_count));
-#else
         for (__u8 i = 0; i < frame_to_send.len; ++i) {
             frame_to_send.data[i] = static_cast<__u8>(thread_id + i);
         }
-#endif
 
         if (senders[interface_rr_index]) {
             (void)senders[interface_rr_index]
@@ -184,7 +174,15 @@ int main() {
             std::string if_name = VCAN_BASENAME + std::to_string(i);
             std::cout << "Bringing UP " << if_name << "..." << std::endl;
             try {
-                [[maybe_unused]] auto _ = hycan_interfaces[i]->up();
+                (void)hycan_interfaces[i]
+                    ->up()
+                    .and_then([&] {
+                        return hycan_interfaces[i]->set_latency_recording(
+                            true);
+                    })
+                    .or_else([&](const auto &e) {
+                        std::cerr << e.message << std::endl;
+                    });
             } catch (const std::exception &e) {
                 std::cerr << "ERROR: Exception during Interface::up() for "
                           << if_name << ": " << e.what() << std::endl;
@@ -258,48 +256,36 @@ int main() {
     }
     std::cout << "Total messages received across all interfaces: "
               << total_received_across_all_interfaces << std::endl;
-#ifdef HYCAN_LATENCY_TEST
-    std::cout << "\n--- Latency Test Results ---" << std::endl;
-    uint64_t overall_latency_messages = 0;
-    double overall_weighted_latency_sum_us = 0.0;
-
+    std::cout << "\n--- Latency Results (kernel rx to callback) ---"
+              << std::endl;
+    std::cout << std::setw(16) << "interface" << std::setw(10) << "count"
+              << std::setw(10) << "min us" << std::setw(10) << "p50 us"
+              << std::setw(10) << "p99 us" << std::setw(10) << "p99.9 us"
+              << std::setw(10) << "max us" << std::endl;
+    const auto us = [](const uint64_t ns) {
+        return static_cast<double>(ns) / 1000.0;
+    };
     for (int i = 0; i < NUM_INTERFACES; ++i) {
-        if (hycan_interfaces[i]) {
-            // 确保接口对象有效
-            std::string if_name = VCAN_BASENAME + std::to_string(i);
-
-            if (const HyCAN::Dispatcher::LatencyStats stats =
-                    hycan_interfaces[i]->get_reaper_latency_stats();
-                stats.message_count > 0) {
-                std::cout << "Interface " << if_name << ": Avg Latency "
-                          << std::fixed << std::setprecision(2)
-                          << stats.average_latency_us << " us "
-                          << "(" << stats.message_count << " msgs)"
-                          << std::endl;
-                overall_latency_messages += stats.message_count;
-                overall_weighted_latency_sum_us +=
-                    stats.average_latency_us *
-                    static_cast<double>(stats.message_count);
-            } else {
-                std::cout << "Interface " << if_name
-                          << ": No latency messages processed." << std::endl;
-            }
+        if (!hycan_interfaces[i]) {
+            continue;
         }
+        // Each interface listens to a single ID, so the per-ID histogram
+        // is the interface-wide one.
+        const auto latency = hycan_interfaces[i]->get_latency(BASE_CAN_ID + i);
+        if (!latency || latency->count == 0) {
+            std::cout << std::setw(16) << VCAN_BASENAME + std::to_string(i)
+                      << ": No latency samples recorded." << std::endl;
+            continue;
+        }
+        std::cout << std::setw(16) << VCAN_BASENAME + std::to_string(i)
+                  << std::setw(10) << latency->count << std::fixed
+                  << std::setprecision(2) << std::setw(10)
+                  << us(latency->min_ns) << std::setw(10)
+                  << us(latency->percentile(50)) << std::setw(10)
+                  << us(latency->percentile(99)) << std::setw(10)
+                  << us(latency->percentile(99.9)) << std::setw(10)
+                  << us(latency->max_ns) << std::endl;
     }
-    if (overall_latency_messages > 0) {
-        const double final_overall_avg_latency_us =
-            overall_weighted_latency_sum_us /
-            static_cast<double>(overall_latency_messages);
-        std::cout << "Overall Average Latency: " << std::fixed
-                  << std::setprecision(2) << final_overall_avg_latency_us
-                  << " us "
-                  << "(" << overall_latency_messages << " total msgs)"
-                  << std::endl;
-    } else {
-        std::cout << "No latency messages processed overall for any interface."
-                  << std::endl;
-    }
-#endif
 
     std::cout << "\n--- HyCAN Interface Stress Test Finished ---" << std::endl;
     return EXIT_SUCCESS;
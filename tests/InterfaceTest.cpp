@@ -7,9 +7,12 @@
 #include <optional> // To store received frame
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "HyCAN/Interface/Interface.hpp" // Adjust path if necessary
+#include "HyCAN/Interface/StaticDispatcher.hpp"
 #include <linux/can.h>
+#include <linux/can/error.h>
 
 // Test constants
 const std::string TEST_INTERFACE_NAME =
@@ -18,10 +21,14 @@ constexpr canid_t TEST_CAN_ID = 0x1A3; // A distinct CAN ID for testing
 constexpr __u8 TEST_DLC = 8;
 const std::array<__u8, TEST_DLC> TEST_DATA = {0x11, 0x22, 0x33, 0x44,
                                               0x55, 0x66, 0x77, 0x88};
+constexpr canid_t TEST_FD_CAN_ID = 0x1A4;
+constexpr __u8 TEST_FD_LEN = CANFD_MAX_DLEN;
 
 // Globals for callback verification
 std::atomic g_callback_triggered{false};
 std::optional<can_frame> g_received_frame;
+std::atomic g_fd_callback_triggered{false};
+canfd_frame g_received_fd_frame{};
 // std::mutex g_frame_mutex; // Potentially needed for more complex scenarios
 
 // Test callback function
@@ -43,6 +50,16 @@ void test_can_callback(can_frame frame) {
     // }
 }
 
+// Static handlers for Test 1j.
+std::atomic<int> g_static_motor_calls{0};
+std::atomic<int> g_static_fd_calls{0};
+
+void static_motor_callback(const can_frame frame) {
+    if (frame.data[0] == TEST_DATA[0]) {
+        ++g_static_motor_calls;
+    }
+}
+
 // Helper to compare can_frames
 bool compare_can_frames(const can_frame &f1, const can_frame &f2) {
     if (f1.can_id != f2.can_id || f1.len != f2.len) {
@@ -80,6 +97,18 @@ int main() {
             std::cerr << "FAIL: " << e.message;
             result_code = EXIT_FAILURE;
         });
+    (void)interface
+        .register_callback<canfd_frame>({TEST_FD_CAN_ID},
+                                        [](const canfd_frame frame) {
+                                            g_received_fd_frame = frame;
+                                            g_fd_callback_triggered.store(
+                                                true,
+                                                std::memory_order_release);
+                                        })
+        .or_else([&](const auto &e) {
+            std::cerr << "FAIL: " << e.message;
+            result_code = EXIT_FAILURE;
+        });
 
     // --- Test 1: Interface UP and Send/Receive ---
     std::cout << "\nTEST 1: Bringing interface UP and testing send/receive..."
@@ -142,6 +171,901 @@ int main() {
         }
     }
 
+    // --- Test 1b: CAN FD Send/Receive ---
+    std::cout << "\nTEST 1b: Testing CAN FD send/receive with "
+              << static_cast<int>(TEST_FD_LEN) << " byte payload..."
+              << std::endl;
+    canfd_frame fd_frame_to_send{};
+    fd_frame_to_send.can_id = TEST_FD_CAN_ID;
+    fd_frame_to_send.len = TEST_FD_LEN;
+    fd_frame_to_send.flags = CANFD_BRS;
+    for (__u8 i = 0; i < TEST_FD_LEN; ++i) {
+        fd_frame_to_send.data[i] = i;
+    }
+    if (auto res = interface.send(fd_frame_to_send); !res) {
+        // Interfaces created before FD support have a classic MTU.
+        std::cout << "SKIP: CAN FD frame not accepted: " << res.error().message
+                  << std::endl;
+    } else {
+        bool fd_triggered = false;
+        for (int i = 0; i < 20; ++i) {
+            if (g_fd_callback_triggered.load(std::memory_order_acquire)) {
+                fd_triggered = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        if (!fd_triggered) {
+            std::cerr << "FAIL: CAN FD callback was not triggered."
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else if (g_received_fd_frame.len != TEST_FD_LEN ||
+                   std::memcmp(g_received_fd_frame.data,
+                               fd_frame_to_send.data, TEST_FD_LEN) != 0) {
+            std::cerr << "FAIL: Received CAN FD frame does not match the sent "
+                         "frame."
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: CAN FD frame received intact." << std::endl;
+        }
+    }
+
+    // --- Test 1c: Unregistered IDs are filtered in the kernel ---
+    std::cout << "\nTEST 1c: Unregistering ID 0x" << std::hex << TEST_CAN_ID
+              << std::dec << " and verifying the kernel filter drops it..."
+              << std::endl;
+    (void)interface.unregister_callback({TEST_CAN_ID})
+        .or_else([&](const auto &e) {
+            std::cerr << "FAIL: " << e.message;
+            result_code = EXIT_FAILURE;
+        });
+    g_callback_triggered.store(false, std::memory_order_relaxed);
+    const uint64_t frames_before = interface.get_receive_stats().frames;
+    (void)interface.send(frame_to_send).or_else([&](const auto &e) {
+        std::cerr << "FAIL: " << e.message;
+        result_code = EXIT_FAILURE;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    if (g_callback_triggered.load(std::memory_order_acquire)) {
+        std::cerr << "FAIL: Callback triggered for an unregistered ID."
+                  << std::endl;
+        result_code = EXIT_FAILURE;
+    } else if (interface.get_receive_stats().frames != frames_before) {
+        std::cerr << "FAIL: Frame for an unregistered ID reached the "
+                     "dispatcher socket."
+                  << std::endl;
+        result_code = EXIT_FAILURE;
+    } else {
+        std::cout << "PASS: Unregistered ID was filtered before reaching the "
+                     "dispatcher."
+                  << std::endl;
+    }
+    (void)interface.register_callback({TEST_CAN_ID}, test_can_callback);
+
+    // --- Test 1d: Several callbacks on one ID, removable by handle ---
+    std::cout << "\nTEST 1d: Adding a second callback on ID 0x" << std::hex
+              << TEST_CAN_ID << std::dec
+              << ", then removing only that one by its handle..."
+              << std::endl;
+    std::atomic<int> second_calls{0};
+    const auto second = interface.register_callback(
+        {TEST_CAN_ID}, [&second_calls](can_frame) {
+            second_calls.fetch_add(1, std::memory_order_relaxed);
+        });
+    if (!second) {
+        std::cerr << "FAIL: " << second.error().message << std::endl;
+        result_code = EXIT_FAILURE;
+    } else {
+        g_callback_triggered.store(false, std::memory_order_relaxed);
+        (void)interface.send(frame_to_send);
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        if (!g_callback_triggered.load(std::memory_order_acquire) ||
+            second_calls.load() != 1) {
+            std::cerr << "FAIL: Both callbacks should run once per frame."
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: Both callbacks received the frame."
+                      << std::endl;
+        }
+
+        (void)interface.unregister_callback(*second);
+        g_callback_triggered.store(false, std::memory_order_relaxed);
+        (void)interface.send(frame_to_send);
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        if (!g_callback_triggered.load(std::memory_order_acquire) ||
+            second_calls.load() != 1) {
+            std::cerr << "FAIL: Removing the handle should leave the first "
+                         "callback in place."
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: Only the removed callback stopped."
+                      << std::endl;
+        }
+    }
+
+    // --- Test 1e: Kernel receive timestamps ---
+    std::cout << "\nTEST 1e: Receiving with kernel timestamps on a second "
+                 "interface object..."
+              << std::endl;
+    {
+        HyCAN::VCANInterface stamped(TEST_INTERFACE_NAME, std::nullopt,
+                                     {.rx_timestamps = true});
+        std::atomic<int64_t> stamp_ns{0};
+        const auto registered =
+            stamped
+                .register_callback({TEST_CAN_ID},
+                                   [&stamp_ns](can_frame,
+                                               HyCAN::RxTimestamp stamp) {
+                                       stamp_ns.store(
+                                           stamp.time_since_epoch().count());
+                                   })
+                .and_then(
+                    [&](HyCAN::CallbackHandle) { return stamped.up(); });
+        if (!registered) {
+            std::cerr << "FAIL: " << registered.error().message << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            const auto before = std::chrono::system_clock::now();
+            (void)stamped.send(frame_to_send);
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            const auto stamp = HyCAN::RxTimestamp(
+                std::chrono::nanoseconds(stamp_ns.load()));
+            const auto stages = stamped.get_stage_stats();
+            if (stamp < before ||
+                stamp > std::chrono::system_clock::now() ||
+                stages.frames != 1) {
+                std::cerr << "FAIL: Expected one frame stamped after the "
+                             "send, got "
+                          << stages.frames << " frame(s)." << std::endl;
+                result_code = EXIT_FAILURE;
+            } else {
+                std::cout << "PASS: Timestamp received; kernel->read "
+                          << stages.kernel_to_read.total_ns
+                          << " ns, read->callback "
+                          << stages.read_to_callback.total_ns
+                          << " ns, callback " << stages.callback.total_ns
+                          << " ns." << std::endl;
+            }
+        }
+    }
+
+    // --- Test 1f: Per-ID traffic statistics ---
+    std::cout << "\nTEST 1f: Counting per-ID traffic, with and without a "
+                 "callback..."
+              << std::endl;
+    {
+        HyCAN::VCANInterface counted(TEST_INTERFACE_NAME, std::nullopt,
+                                     {.kernel_filter = false});
+        const auto registered =
+            counted.register_callback({TEST_CAN_ID}, [](can_frame) {})
+                .and_then(
+                    [&](HyCAN::CallbackHandle) { return counted.up(); });
+        if (!registered) {
+            std::cerr << "FAIL: " << registered.error().message << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            can_frame unclaimed = frame_to_send;
+            unclaimed.can_id = TEST_CAN_ID + 0x10;
+            for (int i = 0; i < 3; ++i) {
+                (void)counted.send(frame_to_send);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            (void)counted.send(unclaimed);
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            const auto claimed_stats = counted.get_id_stats(TEST_CAN_ID);
+            const auto unclaimed_stats =
+                counted.get_id_stats(unclaimed.can_id);
+            if (!claimed_stats || claimed_stats->frames != 3 ||
+                claimed_stats->dropped != 0 ||
+                claimed_stats->mean_interval.count() <= 0 ||
+                !unclaimed_stats || unclaimed_stats->dropped != 1) {
+                std::cerr << "FAIL: Per-ID counters do not match the frames "
+                             "sent."
+                          << std::endl;
+                result_code = EXIT_FAILURE;
+            } else {
+                std::cout << "PASS: " << claimed_stats->frames
+                          << " frames, mean interval "
+                          << claimed_stats->mean_interval.count()
+                          << " ns, jitter " << claimed_stats->jitter.count()
+                          << " ns; " << unclaimed_stats->dropped
+                          << " frame dropped without a callback."
+                          << std::endl;
+            }
+        }
+    }
+
+    // --- Test 1g: Receive-queue overflow ---
+    std::cout << "\nTEST 1g: Overflowing a small receive buffer behind a "
+                 "stalled callback..."
+              << std::endl;
+    {
+        HyCAN::VCANInterface stalled(TEST_INTERFACE_NAME, std::nullopt,
+                                     {.receive_buffer = 4096});
+        std::atomic<int> delivered{0};
+        const canid_t overflow_id = TEST_CAN_ID + 0x20;
+        const auto registered =
+            stalled
+                .register_callback({overflow_id},
+                                   [&delivered](can_frame) {
+                                       if (delivered.fetch_add(1) == 0) {
+                                           std::this_thread::sleep_for(
+                                               std::chrono::milliseconds(200));
+                                       }
+                                   })
+                .and_then(
+                    [&](HyCAN::CallbackHandle) { return stalled.up(); });
+        if (!registered) {
+            std::cerr << "FAIL: " << registered.error().message << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            can_frame burst = frame_to_send;
+            burst.can_id = overflow_id;
+            int sent = 0;
+            for (int i = 0; i < 200; ++i) {
+                if (stalled.send(burst)) {
+                    ++sent;
+                }
+                if (i == 0) {
+                    // Let the first frame reach the callback and stall it.
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            const auto stats = stalled.get_receive_stats();
+            const auto buffer = stalled.get_receive_buffer();
+            if (stats.kernel_drops == 0 || !buffer ||
+                static_cast<int>(stats.kernel_drops) + delivered.load() !=
+                    sent) {
+                std::cerr << "FAIL: Sent " << sent << " frames, delivered "
+                          << delivered.load() << ", kernel reported "
+                          << stats.kernel_drops << " dropped." << std::endl;
+                result_code = EXIT_FAILURE;
+            } else {
+                std::cout << "PASS: " << stats.kernel_drops << " of " << sent
+                          << " frames dropped by the kernel with a " << *buffer
+                          << " byte receive buffer." << std::endl;
+            }
+        }
+    }
+
+    // --- Test 1h: Remote and error frames ---
+    std::cout << "\nTEST 1h: Routing RTR and error frames to their own "
+                 "callbacks..."
+              << std::endl;
+    {
+        HyCAN::VCANInterface side(TEST_INTERFACE_NAME);
+        std::atomic<int> data_calls{0};
+        std::atomic<int> remote_calls{0};
+        std::atomic<int> error_calls{0};
+        const auto registered =
+            side.register_callback({TEST_CAN_ID},
+                                   [&data_calls](can_frame) { ++data_calls; })
+                .and_then([&](HyCAN::CallbackHandle) {
+                    return side.register_remote_callback(
+                        {TEST_CAN_ID},
+                        [&remote_calls](can_frame) { ++remote_calls; });
+                })
+                .and_then([&](HyCAN::CallbackHandle) {
+                    return side.register_error_callback(
+                        [&error_calls](can_frame) { ++error_calls; });
+                })
+                .and_then([&](HyCAN::CallbackHandle) { return side.up(); });
+        if (!registered) {
+            std::cerr << "FAIL: " << registered.error().message << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            can_frame request{};
+            request.can_id = TEST_CAN_ID | CAN_RTR_FLAG;
+            request.len = 0;
+            can_frame bus_off{};
+            bus_off.can_id = CAN_ERR_FLAG | CAN_ERR_BUSOFF | CAN_ERR_CRTL;
+            bus_off.len = CAN_ERR_DLC;
+            bus_off.data[1] = CAN_ERR_CRTL_TX_PASSIVE;
+            (void)side.send(request);
+            (void)side.send(bus_off);
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            const auto errors = side.get_bus_errors();
+            if (data_calls.load() != 0 || remote_calls.load() != 1 ||
+                error_calls.load() != 1 || errors.bus_off != 1 ||
+                errors.error_passive != 1 ||
+                errors.state != HyCAN::BusState::BusOff) {
+                std::cerr << "FAIL: Got " << data_calls.load()
+                          << " data, " << remote_calls.load()
+                          << " remote and " << error_calls.load()
+                          << " error callback(s); bus-off count "
+                          << errors.bus_off << "." << std::endl;
+                result_code = EXIT_FAILURE;
+            } else {
+                std::cout << "PASS: RTR and error frames reached their own "
+                             "callbacks; bus state is bus-off."
+                          << std::endl;
+            }
+        }
+    }
+
+    // --- Test 1i: Range and id/mask subscriptions ---
+    std::cout << "\nTEST 1i: Subscribing to an ID range and an extended "
+                 "id/mask block..."
+              << std::endl;
+    {
+        HyCAN::VCANInterface patterned(TEST_INTERFACE_NAME);
+        std::atomic<int> range_calls{0};
+        std::atomic<int> mask_calls{0};
+        HyCAN::CallbackHandle mask_handle;
+        const auto registered =
+            patterned
+                .register_callback({HyCAN::IdPattern::range(0x201, 0x20B)},
+                                   [&range_calls](can_frame) {
+                                       ++range_calls;
+                                   })
+                .and_then([&](HyCAN::CallbackHandle) {
+                    // Every extended ID 0x18FFxxxx: too many to list.
+                    return patterned.register_callback(
+                        {HyCAN::IdPattern::match(CAN_EFF_FLAG | 0x18FF0000,
+                                                 0x1FFF0000)},
+                        [&mask_calls](can_frame) { ++mask_calls; });
+                })
+                .and_then([&](const HyCAN::CallbackHandle handle) {
+                    mask_handle = handle;
+                    return patterned.up();
+                });
+        if (!registered) {
+            std::cerr << "FAIL: " << registered.error().message << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            can_frame probe = frame_to_send;
+            for (const canid_t id :
+                 {0x200u, 0x201u, 0x205u, 0x20Bu, 0x20Cu,
+                  CAN_EFF_FLAG | 0x18FF1234u, CAN_EFF_FLAG | 0x18FE1234u}) {
+                probe.can_id = id;
+                (void)patterned.send(probe);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            if (range_calls.load() != 3 || mask_calls.load() != 1) {
+                std::cerr << "FAIL: Expected 3 range and 1 mask callback(s), "
+                             "got "
+                          << range_calls.load() << " and "
+                          << mask_calls.load() << "." << std::endl;
+                result_code = EXIT_FAILURE;
+            } else {
+                std::cout << "PASS: Only IDs inside the patterns were "
+                             "delivered."
+                          << std::endl;
+            }
+            // Unregistering an exact ID inside the block by ID must leave
+            // the block's handle able to unregister it.
+            const std::set<size_t> inside{CAN_EFF_FLAG | 0x18FF0005u};
+            std::atomic<int> exact_calls{0};
+            const auto unregistered =
+                patterned
+                    .register_callback(
+                        inside, [&exact_calls](can_frame) { ++exact_calls; })
+                    .and_then([&](HyCAN::CallbackHandle) {
+                        return patterned.unregister_callback(inside);
+                    })
+                    .and_then([&] {
+                        return patterned.unregister_callback(mask_handle);
+                    });
+            mask_calls = 0;
+            for (const canid_t id :
+                 {CAN_EFF_FLAG | 0x18FF0005u, CAN_EFF_FLAG | 0x18FF0006u}) {
+                probe.can_id = id;
+                (void)patterned.send(probe);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            if (!unregistered) {
+                std::cerr << "FAIL: " << unregistered.error().message
+                          << std::endl;
+                result_code = EXIT_FAILURE;
+            } else if (mask_calls.load() != 0 || exact_calls.load() != 0) {
+                std::cerr << "FAIL: Expected no callbacks after "
+                             "unregistering, got "
+                          << mask_calls.load() << " mask and "
+                          << exact_calls.load() << " exact." << std::endl;
+                result_code = EXIT_FAILURE;
+            } else {
+                std::cout << "PASS: The block unregistered after an exact ID "
+                             "inside it."
+                          << std::endl;
+            }
+        }
+    }
+
+    // --- Test 1j: Compile-time handlers ---
+    std::cout << "\nTEST 1j: Dispatching to compile-time handlers..."
+              << std::endl;
+    {
+        HyCAN::StaticDispatcher<
+            HyCAN::Handler<0x201, &static_motor_callback>,
+            HyCAN::Handler<0x202, [](const canfd_frame &) {
+                ++g_static_fd_calls;
+            }, canfd_frame>>
+            fixed(TEST_INTERFACE_NAME);
+        std::atomic<int> dynamic_calls{0};
+        const auto started =
+            fixed.dynamic()
+                .register_func({0x203},
+                               [&dynamic_calls](can_frame) { ++dynamic_calls; })
+                .and_then([&](HyCAN::CallbackHandle) { return fixed.start(); });
+        if (!started) {
+            std::cerr << "FAIL: " << started.error().message << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            can_frame probe = frame_to_send;
+            for (const canid_t id : {0x201u, 0x202u, 0x203u, 0x204u, 0x201u}) {
+                probe.can_id = id;
+                (void)interface.send(probe);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            (void)fixed.stop();
+            if (g_static_motor_calls.load() != 2 ||
+                g_static_fd_calls.load() != 1 || dynamic_calls.load() != 1) {
+                std::cerr << "FAIL: Expected 2, 1 and 1 call(s), got "
+                          << g_static_motor_calls.load() << ", "
+                          << g_static_fd_calls.load() << " and "
+                          << dynamic_calls.load() << "." << std::endl;
+                result_code = EXIT_FAILURE;
+            } else {
+                std::cout << "PASS: Static handlers and runtime callbacks "
+                             "shared one dispatcher."
+                          << std::endl;
+            }
+        }
+    }
+
+    // --- Test 1k: Awaiting replies in a coroutine ---
+    std::cout << "\nTEST 1k: Request/response with co_await..." << std::endl;
+    {
+        // Echoes every request on 0x601 back on 0x581.
+        HyCAN::Sender responder(TEST_INTERFACE_NAME);
+        const auto echo = interface.register_callback(
+            {0x601}, [&responder](can_frame request) {
+                request.can_id = 0x581;
+                (void)responder.send(request);
+            });
+        HyCAN::VCANInterface client(TEST_INTERFACE_NAME);
+        HyCAN::Executor executor;
+        int replies = 0;
+        bool timed_out = false;
+        const auto query = [&]() -> HyCAN::Task<void> {
+            for (uint8_t i = 0; i < 3; ++i) {
+                // Listening starts here, before the request goes out.
+                auto reply = client.receive(0x581, std::chrono::seconds(1));
+                can_frame request = frame_to_send;
+                request.can_id = 0x601;
+                request.data[0] = i;
+                if (!co_await client.send_async(request)) {
+                    co_return;
+                }
+                if (const auto frame = co_await reply;
+                    frame && frame->data[0] == i) {
+                    ++replies;
+                }
+            }
+            const auto silence =
+                co_await client.receive(0x582, std::chrono::milliseconds(50));
+            timed_out = !silence && silence.error().code ==
+                                        HyCAN::ErrorCode::ReceiveTimeout;
+        };
+        const auto ran = echo.and_then([&](HyCAN::CallbackHandle) {
+                                 return client.up();
+                             })
+                             .and_then([&] {
+                                 executor.spawn(query());
+                                 return executor.run();
+                             });
+        if (echo) {
+            (void)interface.unregister_callback(*echo);
+        }
+        // With no await left, the kernel filters the reply ID again.
+        const uint64_t frames_before = client.get_receive_stats().frames;
+        can_frame late = frame_to_send;
+        late.can_id = 0x581;
+        (void)interface.send(late);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const bool refiltered =
+            client.get_receive_stats().frames == frames_before;
+        if (!ran) {
+            std::cerr << "FAIL: " << ran.error().message << std::endl;
+            result_code = EXIT_FAILURE;
+        } else if (!refiltered) {
+            std::cerr << "FAIL: A reply ID stayed in the kernel filter after "
+                         "its await finished."
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else if (replies != 3 || !timed_out) {
+            std::cerr << "FAIL: Expected 3 replies and a timeout, got "
+                      << replies << " and "
+                      << (timed_out ? "a timeout" : "none") << "."
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: Every reply was awaited and the silent ID "
+                         "timed out."
+                      << std::endl;
+        }
+    }
+
+    // --- Test 1l: Latest-value mailbox ---
+    std::cout << "\nTEST 1l: Polling the newest frame from a mailbox..."
+              << std::endl;
+    if (auto mailbox = interface.register_mailbox({0x301, 0x302}); !mailbox) {
+        std::cerr << "FAIL: " << mailbox.error().message << std::endl;
+        result_code = EXIT_FAILURE;
+    } else {
+        can_frame frame = frame_to_send;
+        frame.can_id = 0x301;
+        for (uint8_t i = 1; i <= 3; ++i) {
+            frame.data[0] = i;
+            (void)interface.send(frame);
+        }
+        for (int i = 0; i < 20 && (*mailbox)->sequence(0x301) < 3; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        const auto sample = (*mailbox)->read(0x301);
+        if (!sample || sample->sequence != 3 || sample->frame.data[0] != 3 ||
+            sample->timestamp == HyCAN::RxTimestamp{}) {
+            std::cerr << "FAIL: Expected the third frame as sample 3."
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else if ((*mailbox)->read(0x302) || (*mailbox)->read(0x303)) {
+            std::cerr << "FAIL: Silent and unknown IDs should be empty."
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: The mailbox held the newest frame and its "
+                         "sequence number."
+                      << std::endl;
+        }
+        (void)interface.unregister_callback((*mailbox)->handle());
+    }
+
+    // --- Test 1m: Freshness deadline ---
+    std::cout << "\nTEST 1m: Timing out an ID that goes quiet..." << std::endl;
+    {
+        std::atomic<int> timeouts{0};
+        std::atomic<size_t> stale_id{0};
+        const auto watched = interface.register_callback(
+            {0x311}, [](const can_frame &) {},
+            HyCAN::Freshness{std::chrono::milliseconds(50),
+                             [&](const size_t can_id) {
+                                 stale_id = can_id;
+                                 ++timeouts;
+                             }});
+        can_frame frame = frame_to_send;
+        frame.can_id = 0x311;
+        // Fresh for 200 ms, quiet for 150 ms, then once more.
+        for (int i = 0; i < 20; ++i) {
+            (void)interface.send(frame);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        const int while_fresh = timeouts.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        const int after_silence = timeouts.load();
+        (void)interface.send(frame);
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        if (watched) {
+            (void)interface.unregister_callback(*watched);
+        }
+        if (!watched) {
+            std::cerr << "FAIL: " << watched.error().message << std::endl;
+            result_code = EXIT_FAILURE;
+        } else if (while_fresh != 0 || after_silence != 1 ||
+                   timeouts.load() != 2 || stale_id.load() != 0x311) {
+            std::cerr << "FAIL: Expected no timeout while fresh and one per "
+                         "silence, got "
+                      << while_fresh << ", " << after_silence << ", "
+                      << timeouts.load() << "." << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: The quiet ID timed out once per silence."
+                      << std::endl;
+        }
+        // A timeout handler unregistering its own callback; it used to
+        // run under the watchdog's lock and deadlock the reap thread.
+        std::atomic<int> dropped_timeouts{0};
+        std::atomic<uint64_t> dropped_id{0};
+        const auto dropping = interface.register_callback(
+            {0x312}, [](const can_frame &) {},
+            HyCAN::Freshness{std::chrono::milliseconds(20),
+                             [&](size_t) {
+                                 ++dropped_timeouts;
+                                 (void)interface.unregister_callback(
+                                     HyCAN::CallbackHandle{dropped_id.load()});
+                             }});
+        if (dropping) {
+            dropped_id = dropping->id;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        // Unwatched, so neither this frame nor the silence after it counts.
+        frame.can_id = 0x312;
+        (void)interface.send(frame);
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        if (!dropping || dropped_timeouts.load() != 1) {
+            std::cerr << "FAIL: Expected one timeout before the handler "
+                         "unregistered itself, got "
+                      << dropped_timeouts.load() << "." << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: A timeout handler unregistered its own "
+                         "callback."
+                      << std::endl;
+        }
+    }
+
+    // --- Test 1n: Batch send ---
+    std::cout << "\nTEST 1n: Sending a cycle of frames with one call..."
+              << std::endl;
+    {
+        std::array<can_frame, 16> cycle{};
+        for (uint8_t i = 0; i < cycle.size(); ++i) {
+            cycle[i] = frame_to_send;
+            cycle[i].can_id = 0x321;
+            cycle[i].data[0] = i;
+        }
+        std::atomic<int> in_order{0};
+        const auto counted = interface.register_callback(
+            {0x321}, [&in_order](const can_frame &frame) {
+                if (frame.data[0] == in_order.load()) {
+                    ++in_order;
+                }
+            });
+        const auto sent = interface.send_batch<can_frame>(cycle);
+        for (int i = 0; i < 20 && in_order.load() < 16; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (counted) {
+            (void)interface.unregister_callback(*counted);
+        }
+        if (!sent) {
+            std::cerr << "FAIL: Only " << sent.sent << " frames went out: "
+                      << sent.status.error().message << std::endl;
+            result_code = EXIT_FAILURE;
+        } else if (sent.sent != cycle.size() || in_order.load() != 16) {
+            std::cerr << "FAIL: Expected 16 frames in order, got "
+                      << in_order.load() << "." << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: All 16 frames arrived in order." << std::endl;
+        }
+    }
+
+    // --- Test 1o: Queued transmit from several threads ---
+    std::cout << "\nTEST 1o: Enqueueing from four threads at once..."
+              << std::endl;
+    {
+        constexpr int PRODUCERS = 4;
+        constexpr int FRAMES_EACH = 200;
+        std::array<std::atomic<int>, PRODUCERS> next{};
+        std::atomic<int> out_of_order{0};
+        const auto counted = interface.register_callback(
+            {0x331}, [&](const can_frame &frame) {
+                const uint8_t producer = frame.data[0];
+                if (producer >= PRODUCERS ||
+                    frame.data[1] != next[producer]++ % 256) {
+                    ++out_of_order;
+                }
+            });
+        interface.enable_tx_queue();
+        std::vector<std::thread> producers;
+        for (uint8_t p = 0; p < PRODUCERS; ++p) {
+            producers.emplace_back([&interface, p] {
+                can_frame frame{};
+                frame.can_id = 0x331;
+                frame.len = 2;
+                frame.data[0] = p;
+                for (int i = 0; i < FRAMES_EACH; ++i) {
+                    frame.data[1] = static_cast<uint8_t>(i);
+                    while (!interface.enqueue(frame)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto &producer : producers) {
+            producer.join();
+        }
+        const bool flushed = interface.flush_tx_queue(std::chrono::seconds(2));
+        int received = 0;
+        for (int i = 0; i < 20; ++i) {
+            received = 0;
+            for (const auto &count : next) {
+                received += count.load();
+            }
+            if (received == PRODUCERS * FRAMES_EACH) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (counted) {
+            (void)interface.unregister_callback(*counted);
+        }
+        const auto stats = interface.get_tx_queue_stats();
+        if (!flushed || !stats || stats->sent != PRODUCERS * FRAMES_EACH ||
+            received != PRODUCERS * FRAMES_EACH || out_of_order.load() != 0) {
+            std::cerr << "FAIL: Expected " << PRODUCERS * FRAMES_EACH
+                      << " frames in per-thread order, received " << received
+                      << " (" << out_of_order.load() << " out of order)."
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: Every queued frame arrived in its thread's "
+                         "order."
+                      << std::endl;
+        }
+    }
+
+    // --- Test 1p: Kernel-timed cyclic frames ---
+    std::cout << "\nTEST 1p: Handing a 5 ms heartbeat to the broadcast "
+                 "manager..."
+              << std::endl;
+    {
+        can_frame heartbeat{};
+        heartbeat.can_id = 0x341;
+        heartbeat.len = 1;
+        heartbeat.data[0] = 0x01;
+        std::atomic<int> old_payload{0};
+        std::atomic<int> new_payload{0};
+        const auto counted = interface.register_callback(
+            {0x341}, [&](const can_frame &frame) {
+                ++(frame.data[0] == 0x01 ? old_payload : new_payload);
+            });
+        // A second BCM socket reports only the payload changes it sees.
+        HyCAN::CyclicSender watcher(TEST_INTERFACE_NAME);
+        can_frame mask{};
+        mask.can_id = 0x341;
+        mask.len = 1;
+        mask.data[0] = 0xFF;
+        auto res = watcher.watch(mask).and_then([&] {
+            return interface.start_cyclic(heartbeat,
+                                          std::chrono::milliseconds(5));
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        heartbeat.data[0] = 0x02;
+        if (res) {
+            res = interface.update_cyclic(heartbeat);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (res) {
+            res = interface.stop_cyclic(0x341);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const int after_stop = old_payload.load() + new_payload.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        int changes = 0;
+        while (const auto event = watcher.read_event()) {
+            if (!*event) {
+                break;
+            }
+            if ((*event)->kind == HyCAN::CyclicEvent::Kind::Changed) {
+                ++changes;
+            }
+        }
+        if (counted) {
+            (void)interface.unregister_callback(*counted);
+        }
+        if (!res) {
+            std::cerr << "FAIL: Cyclic send failed: " << res.error().message
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+        } else if (old_payload.load() < 10 || new_payload.load() < 10 ||
+                   old_payload.load() + new_payload.load() != after_stop ||
+                   changes != 2) {
+            std::cerr << "FAIL: Expected two runs of ~20 frames that end at "
+                         "stop and 2 changes, got "
+                      << old_payload.load() << " + " << new_payload.load()
+                      << " frames and " << changes << " changes." << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: The kernel sent " << old_payload.load()
+                      << " + " << new_payload.load()
+                      << " heartbeats and reported 2 changes." << std::endl;
+        }
+    }
+
+    // --- Test 1q: Sending with backpressure ---
+    std::cout << "\nTEST 1q: Sending a burst that waits for room instead of "
+                 "failing..."
+              << std::endl;
+    {
+        constexpr int BURST = 2000;
+        std::atomic<int> received{0};
+        const auto counted = interface.register_callback(
+            {0x351}, [&received](const can_frame &) { ++received; });
+        can_frame frame{};
+        frame.can_id = 0x351;
+        frame.len = 8;
+        int failed = 0;
+        for (int i = 0; i < BURST; ++i) {
+            if (!interface.send_blocking(frame,
+                                         std::chrono::milliseconds(100))) {
+                ++failed;
+            }
+        }
+        for (int i = 0; i < 20 && received.load() < BURST; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (counted) {
+            (void)interface.unregister_callback(*counted);
+        }
+        const auto blocked = interface.get_send_block_stats();
+        if (failed != 0 || blocked.timeouts != 0) {
+            std::cerr << "FAIL: " << failed << " of " << BURST
+                      << " blocking sends failed." << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: All " << BURST << " frames went out ("
+                      << received.load() << " received); the socket was "
+                      << "full " << blocked.full << " times, "
+                      << blocked.blocked_total_ns / 1000 << " us blocked."
+                      << std::endl;
+        }
+    }
+
+    // --- Test 1r: A deferred callback removing itself ---
+    std::cout << "\nTEST 1r: Unregistering a deferred callback from inside "
+                 "itself..."
+              << std::endl;
+    {
+        std::optional<HyCAN::CallbackHandle> self;
+        std::atomic<int> calls{0};
+        std::atomic<bool> done{false};
+        std::atomic<bool> intact{false};
+        const auto registered = interface.register_callback(
+            {0x361},
+            [&, payload = std::vector<uint8_t>(256, 0x5A)](const can_frame &) {
+                if (calls++ != 0 || !self) {
+                    return;
+                }
+                (void)interface.unregister_callback(*self);
+                // This callback now lives in a retired table; give the
+                // reap thread a chance to free it if it wrongly would.
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                bool same = true;
+                for (const uint8_t byte : payload) {
+                    same = same && byte == 0x5A;
+                }
+                intact = same;
+                done = true;
+            },
+            HyCAN::Delivery::Deferred);
+        can_frame frame{};
+        frame.can_id = 0x361;
+        frame.len = 1;
+        if (registered) {
+            self = *registered;
+            (void)interface.send(frame);
+        }
+        for (int i = 0; i < 50 && !done.load(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        // Gone from the table: this frame must not reach it.
+        (void)interface.send(frame);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        if (!registered || !done.load() || !intact.load() ||
+            calls.load() != 1) {
+            std::cerr << "FAIL: Expected one call that still saw its "
+                         "captures, got "
+                      << calls.load() << " calls (intact: " << intact.load()
+                      << ")." << std::endl;
+            result_code = EXIT_FAILURE;
+        } else {
+            std::cout << "PASS: The callback removed itself and kept its "
+                         "captures until it returned."
+                      << std::endl;
+        }
+    }
+
     // --- Test 2: Interface DOWN and Verify No More Callbacks ---
     std::cout << "\nTEST 2: Bringing interface DOWN and verifying no messages "
                  "are received..."
@@ -0,0 +1,158 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <sys/resource.h>
+#include <linux/can.h>
+
+#include "HyCAN/Interface/Dispatcher.hpp"
+#include "HyCAN/Interface/IPCManager.hpp"
+#include "HyCAN/Interface/Sender.hpp"
+
+// --- Benchmark Configuration ---
+const std::string TEST_INTERFACE_NAME = "vcan_hybatch";
+constexpr canid_t TEST_CAN_ID = 0x321;
+constexpr uint64_t FRAMES_PER_RUN = 200000;
+const std::array<HyCAN::DispatcherOptions, 6> RUN_OPTIONS = {{
+    {.batch_size = 1, .wakeup_budget = 1},
+    {.batch_size = 8, .wakeup_budget = 8},
+    {.batch_size = 32, .wakeup_budget = 32},
+    {.batch_size = 64, .wakeup_budget = 64},
+    {.batch_size = 32, .wakeup_budget = 256},
+    {.batch_size = 32, .edge_triggered = true, .wakeup_budget = 256},
+}};
+constexpr auto DRAIN_TIMEOUT = std::chrono::seconds(5);
+
+std::atomic<uint64_t> g_received{0};
+
+// Process CPU time in nanoseconds (reap thread + sender).
+uint64_t process_cpu_ns() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    const auto to_ns = [](const timeval &tv) {
+        return static_cast<uint64_t>(tv.tv_sec) * 1000000000ULL +
+               static_cast<uint64_t>(tv.tv_usec) * 1000ULL;
+    };
+    return to_ns(usage.ru_utime) + to_ns(usage.ru_stime);
+}
+
+// CPU time of the calling thread in nanoseconds.
+uint64_t thread_cpu_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+           static_cast<uint64_t>(ts.tv_nsec);
+}
+
+struct RunResult {
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    HyCAN::Dispatcher::ReceiveStats stats{};
+    uint64_t reap_cpu_ns = 0;
+};
+
+RunResult run_batch(const HyCAN::DispatcherOptions &options) {
+    RunResult result;
+    g_received.store(0, std::memory_order_relaxed);
+
+    HyCAN::Dispatcher dispatcher(TEST_INTERFACE_NAME, std::nullopt, options);
+    (void)dispatcher
+        .register_func({TEST_CAN_ID},
+                       [](can_frame) {
+                           g_received.fetch_add(1, std::memory_order_relaxed);
+                       })
+        .or_else([](const auto &e) { std::cerr << e.message << std::endl; });
+    if (auto res = dispatcher.start(); !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return result;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    HyCAN::Sender sender(TEST_INTERFACE_NAME);
+    can_frame frame{};
+    frame.can_id = TEST_CAN_ID;
+    frame.len = 8;
+
+    const uint64_t cpu_before = process_cpu_ns();
+    const uint64_t sender_cpu_before = thread_cpu_ns();
+    // Saturate the bus: write as fast as the socket accepts frames.
+    while (result.sent < FRAMES_PER_RUN) {
+        frame.data[0] = static_cast<__u8>(result.sent);
+        if (sender.send(frame)) {
+            ++result.sent;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    const uint64_t sender_cpu = thread_cpu_ns() - sender_cpu_before;
+
+    const auto deadline = std::chrono::steady_clock::now() + DRAIN_TIMEOUT;
+    uint64_t last = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const uint64_t now = g_received.load(std::memory_order_relaxed);
+        if (now >= result.sent || (now == last && now != 0))
+            break;
+        last = now;
+    }
+    const uint64_t cpu_total = process_cpu_ns() - cpu_before;
+
+    (void)dispatcher.stop();
+    result.received = g_received.load(std::memory_order_relaxed);
+    result.stats = dispatcher.get_receive_stats();
+    result.reap_cpu_ns = cpu_total > sender_cpu ? cpu_total - sender_cpu : 0;
+    return result;
+}
+
+int main() {
+    std::cout << "--- HyCAN Receive Batch Benchmark ---" << std::endl;
+    std::cout << "INFO: Ensure 'vcan' module is loaded (sudo modprobe vcan)."
+              << std::endl;
+
+    auto &ipc = HyCAN::IPCManager::instance();
+    if (auto res = ipc.create_vcan(TEST_INTERFACE_NAME).and_then(
+            [&] { return ipc.set(TEST_INTERFACE_NAME, true); });
+        !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int result_code = EXIT_SUCCESS;
+    std::cout << std::setw(6) << "batch" << std::setw(8) << "budget"
+              << std::setw(4) << "ET" << std::setw(10) << "sent"
+              << std::setw(10) << "recv" << std::setw(14) << "syscall/frame"
+              << std::setw(14) << "wakeup/frame" << std::setw(14)
+              << "cpu ns/frame" << std::setw(12) << "max/wakeup"
+              << std::setw(10) << "budget!" << std::endl;
+    for (const auto &options : RUN_OPTIONS) {
+        const RunResult r = run_batch(options);
+        if (r.received == 0) {
+            std::cerr << "FAIL: no frames received with batch size "
+                      << options.batch_size << std::endl;
+            result_code = EXIT_FAILURE;
+            continue;
+        }
+        const auto per_frame = [&](const uint64_t v) {
+            return static_cast<double>(v) / static_cast<double>(r.received);
+        };
+        std::cout << std::setw(6) << options.batch_size << std::setw(8)
+                  << options.wakeup_budget << std::setw(4)
+                  << (options.edge_triggered ? "y" : "n") << std::setw(10)
+                  << r.sent << std::setw(10) << r.received << std::fixed
+                  << std::setprecision(3) << std::setw(14)
+                  << per_frame(r.stats.receive_calls) << std::setw(14)
+                  << per_frame(r.stats.wakeups) << std::setprecision(1)
+                  << std::setw(14) << per_frame(r.reap_cpu_ns) << std::setw(12)
+                  << r.stats.max_wakeup_frames << std::setw(10)
+                  << r.stats.budget_exhausted << std::endl;
+    }
+
+    (void)ipc.set(TEST_INTERFACE_NAME, false);
+    std::cout << "\n--- HyCAN Receive Batch Benchmark Finished ---"
+              << std::endl;
+    return result_code;
+}
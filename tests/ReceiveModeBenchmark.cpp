@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+#include <linux/can.h>
+
+#include "HyCAN/Interface/Dispatcher.hpp"
+#include "HyCAN/Interface/IPCManager.hpp"
+#include "HyCAN/Interface/Sender.hpp"
+
+// --- Benchmark Configuration ---
+const std::string TEST_INTERFACE_NAME = "vcan_hymode";
+constexpr canid_t TEST_CAN_ID = 0x322;
+constexpr uint64_t FRAMES_PER_RUN = 20000;
+// Gap between frames; long enough that each frame is a separate wakeup.
+constexpr auto SEND_INTERVAL = std::chrono::microseconds(100);
+constexpr auto DRAIN_TIMEOUT = std::chrono::seconds(2);
+
+struct ModeRun {
+    const char *name;
+    HyCAN::ReceiveMode mode;
+};
+
+constexpr std::array<ModeRun, 4> RUN_MODES = {{
+    {"epoll", HyCAN::ReceiveMode::Epoll},
+    {"blocking", HyCAN::ReceiveMode::Blocking},
+    {"spin", HyCAN::ReceiveMode::Spin},
+    {"hybrid", HyCAN::ReceiveMode::Hybrid},
+}};
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<uint64_t> g_received{0};
+std::vector<uint64_t> g_latencies_ns;
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch())
+            .count());
+}
+
+// Process CPU time in nanoseconds (reap thread + sender).
+uint64_t process_cpu_ns() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    const auto to_ns = [](const timeval &tv) {
+        return static_cast<uint64_t>(tv.tv_sec) * 1000000000ULL +
+               static_cast<uint64_t>(tv.tv_usec) * 1000ULL;
+    };
+    return to_ns(usage.ru_utime) + to_ns(usage.ru_stime);
+}
+
+// CPU time of the calling thread in nanoseconds.
+uint64_t thread_cpu_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+           static_cast<uint64_t>(ts.tv_nsec);
+}
+
+struct RunResult {
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t reap_cpu_ns = 0;
+    double elapsed_s = 0;
+};
+
+RunResult run_mode(const HyCAN::ReceiveMode mode) {
+    RunResult result;
+    g_received.store(0, std::memory_order_relaxed);
+    g_latencies_ns.assign(FRAMES_PER_RUN, 0);
+
+    HyCAN::Dispatcher dispatcher(TEST_INTERFACE_NAME, std::nullopt,
+                                 {.receive_mode = mode});
+    (void)dispatcher
+        .register_func({TEST_CAN_ID},
+                       [](const can_frame &frame) {
+                           const uint64_t received_at = now_ns();
+                           uint64_t sent_at;
+                           std::memcpy(&sent_at, frame.data, sizeof(sent_at));
+                           const uint64_t n = g_received.fetch_add(
+                               1, std::memory_order_relaxed);
+                           if (n < g_latencies_ns.size()) {
+                               g_latencies_ns[n] = received_at - sent_at;
+                           }
+                       })
+        .or_else([](const auto &e) { std::cerr << e.message << std::endl; });
+    if (auto res = dispatcher.start(); !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return result;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    HyCAN::Sender sender(TEST_INTERFACE_NAME);
+    can_frame frame{};
+    frame.can_id = TEST_CAN_ID;
+    frame.len = 8;
+
+    const auto start = Clock::now();
+    const uint64_t cpu_before = process_cpu_ns();
+    const uint64_t sender_cpu_before = thread_cpu_ns();
+    auto next_send = start;
+    while (result.sent < FRAMES_PER_RUN) {
+        // Busy-wait for the slot so the sender itself adds no wakeup jitter.
+        while (Clock::now() < next_send) {
+        }
+        const uint64_t sent_at = now_ns();
+        std::memcpy(frame.data, &sent_at, sizeof(sent_at));
+        if (sender.send(frame)) {
+            ++result.sent;
+        }
+        next_send += SEND_INTERVAL;
+    }
+    const uint64_t sender_cpu = thread_cpu_ns() - sender_cpu_before;
+
+    const auto deadline = Clock::now() + DRAIN_TIMEOUT;
+    while (g_received.load(std::memory_order_relaxed) < result.sent &&
+           Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const uint64_t cpu_total = process_cpu_ns() - cpu_before;
+    result.elapsed_s =
+        std::chrono::duration<double>(Clock::now() - start).count();
+
+    (void)dispatcher.stop();
+    result.received = std::min<uint64_t>(
+        g_received.load(std::memory_order_relaxed), g_latencies_ns.size());
+    result.reap_cpu_ns = cpu_total > sender_cpu ? cpu_total - sender_cpu : 0;
+    if (result.received > 0) {
+        auto latencies = g_latencies_ns;
+        latencies.resize(result.received);
+        std::sort(latencies.begin(), latencies.end());
+        result.p50_ns = latencies[latencies.size() / 2];
+        result.p99_ns = latencies[latencies.size() * 99 / 100];
+        result.max_ns = latencies.back();
+    }
+    return result;
+}
+
+int main() {
+    std::cout << "--- HyCAN Receive Mode Benchmark ---" << std::endl;
+    std::cout << "INFO: Ensure 'vcan' module is loaded (sudo modprobe vcan)."
+              << std::endl;
+
+    auto &ipc = HyCAN::IPCManager::instance();
+    if (auto res = ipc.create_vcan(TEST_INTERFACE_NAME).and_then(
+            [&] { return ipc.set(TEST_INTERFACE_NAME, true); });
+        !res) {
+        std::cerr << "FAIL: " << res.error().message << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int result_code = EXIT_SUCCESS;
+    std::cout << std::setw(10) << "mode" << std::setw(10) << "sent"
+              << std::setw(10) << "recv" << std::setw(12) << "p50 ns"
+              << std::setw(12) << "p99 ns" << std::setw(12) << "max ns"
+              << std::setw(14) << "reap CPU %" << std::endl;
+    for (const auto &[name, mode] : RUN_MODES) {
+        const RunResult r = run_mode(mode);
+        if (r.received == 0) {
+            std::cerr << "FAIL: no frames received in " << name << " mode"
+                      << std::endl;
+            result_code = EXIT_FAILURE;
+            continue;
+        }
+        // Share of one core the receive side used over the run.
+        const double cpu_percent = r.elapsed_s > 0
+                                       ? static_cast<double>(r.reap_cpu_ns) /
+                                             (r.elapsed_s * 1e7)
+                                       : 0.0;
+        std::cout << std::setw(10) << name << std::setw(10) << r.sent
+                  << std::setw(10) << r.received << std::setw(12) << r.p50_ns
+                  << std::setw(12) << r.p99_ns << std::setw(12) << r.max_ns
+                  << std::fixed << std::setprecision(1) << std::setw(14)
+                  << cpu_percent << std::endl;
+    }
+
+    (void)ipc.set(TEST_INTERFACE_NAME, false);
+    std::cout << "\n--- HyCAN Receive Mode Benchmark Finished ---" << std::endl;
+    return result_code;
+}